@@ -2,7 +2,6 @@
 #include "GamboCore.h"
 #include "CPU.h"
 #include "RAM.h"
-#include "imgui.h"
 
 // FF00 - P1/JOYP: Joypad
 // 
@@ -21,6 +20,7 @@
 
 Input::Input(GamboCore* c)
 	: core(c)
+	, buttons(0)
 {
 }
 
@@ -30,30 +30,29 @@ Input::~Input()
 
 void Input::Check() const
 {
-	auto& io = ImGui::GetIO();
 	auto& P1 = core->ram->Get(HWAddr::P1);
 	auto p1Before = P1;
 
 	if (!GetBits(P1, 4, 1) && !GetBits(P1, 5, 1)) // are we looking at both directions and actions?
 	{
-		SetBit(P1, 0, !(ImGui::IsKeyDown(ImGuiKey_RightArrow)	|| ImGui::IsKeyDown(ImGuiKey_Z)));
-		SetBit(P1, 1, !(ImGui::IsKeyDown(ImGuiKey_LeftArrow)	|| ImGui::IsKeyDown(ImGuiKey_X)));
-		SetBit(P1, 2, !(ImGui::IsKeyDown(ImGuiKey_UpArrow)		|| ImGui::IsKeyDown(ImGuiKey_Backspace)));
-		SetBit(P1, 3, !(ImGui::IsKeyDown(ImGuiKey_DownArrow)	|| ImGui::IsKeyDown(ImGuiKey_Enter)));
+		SetBit(P1, 0, !(IsPressed(JoypadButton::Right)	|| IsPressed(JoypadButton::A)));
+		SetBit(P1, 1, !(IsPressed(JoypadButton::Left)	|| IsPressed(JoypadButton::B)));
+		SetBit(P1, 2, !(IsPressed(JoypadButton::Up)		|| IsPressed(JoypadButton::Select)));
+		SetBit(P1, 3, !(IsPressed(JoypadButton::Down)	|| IsPressed(JoypadButton::Start)));
 	}
 	else if (!GetBits(P1, 4, 1)) // are we only looking at directions?
 	{
-		SetBit(P1, 0, !ImGui::IsKeyDown(ImGuiKey_RightArrow));
-		SetBit(P1, 1, !ImGui::IsKeyDown(ImGuiKey_LeftArrow));
-		SetBit(P1, 2, !ImGui::IsKeyDown(ImGuiKey_UpArrow));
-		SetBit(P1, 3, !ImGui::IsKeyDown(ImGuiKey_DownArrow));
+		SetBit(P1, 0, !IsPressed(JoypadButton::Right));
+		SetBit(P1, 1, !IsPressed(JoypadButton::Left));
+		SetBit(P1, 2, !IsPressed(JoypadButton::Up));
+		SetBit(P1, 3, !IsPressed(JoypadButton::Down));
 	}
 	else if (!GetBits(P1, 5, 1)) // are we only looking at actions?
 	{
-		SetBit(P1, 0, !ImGui::IsKeyDown(ImGuiKey_Z));
-		SetBit(P1, 1, !ImGui::IsKeyDown(ImGuiKey_X));
-		SetBit(P1, 2, !ImGui::IsKeyDown(ImGuiKey_Backspace));
-		SetBit(P1, 3, !ImGui::IsKeyDown(ImGuiKey_Enter));
+		SetBit(P1, 0, !IsPressed(JoypadButton::A));
+		SetBit(P1, 1, !IsPressed(JoypadButton::B));
+		SetBit(P1, 2, !IsPressed(JoypadButton::Select));
+		SetBit(P1, 3, !IsPressed(JoypadButton::Start));
 	}
 	else
 	{
@@ -70,3 +69,18 @@ void Input::Check() const
 			core->cpu->RequestInterrupt(InterruptFlags::Joypad);
 	}
 }
+
+void Input::SetButtons(u8 pressed)
+{
+	buttons = pressed;
+}
+
+u8 Input::GetButtons() const
+{
+	return buttons;
+}
+
+bool Input::IsPressed(JoypadButton b) const
+{
+	return (buttons & (u8)b) != 0;
+}
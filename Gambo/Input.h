@@ -1,7 +1,21 @@
 #pragma once
+#include "GamboDefine.h"
 
 class GamboCore;
 
+// bit flags for the eight game boy buttons, as reported by the frontend
+enum class JoypadButton : u8
+{
+	Right	= (1 << 0),
+	Left	= (1 << 1),
+	Up		= (1 << 2),
+	Down	= (1 << 3),
+	A		= (1 << 4),
+	B		= (1 << 5),
+	Select	= (1 << 6),
+	Start	= (1 << 7),
+};
+
 class Input
 {
 public:
@@ -10,7 +24,13 @@ public:
 
 	void Check() const;
 
+	// set which buttons are currently held down. see JoypadButton.
+	void SetButtons(u8 pressed);
+	u8 GetButtons() const;
+
 private:
+	bool IsPressed(JoypadButton b) const;
+
 	GamboCore* core;
+	u8 buttons;
 };
-
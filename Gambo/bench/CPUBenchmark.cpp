@@ -0,0 +1,160 @@
+// measures raw interpreter throughput. runs a synthetic rom (or the rom given
+// on the command line) for a fixed amount of wall time and reports
+// instructions per second and frames per second.
+//
+// usage: gambo_bench [rom.gb] [seconds] [interpreter]
+// pass "" as the rom to use the synthetic one.
+
+#include "GamboCore.h"
+#include "Cartridge.h"
+#include "CPU.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+
+// opcodes that are safe to string together in a straight line. no control
+// flow, no stack, nothing that writes through BC/DE/a16 or moves HL out of wram.
+static bool IsBenchmarkOpcode(u8 op)
+{
+	u8 hi = op >> 4;
+	u8 dst = (op >> 3) & 0b111;
+	u8 src = op & 0b111;
+
+	// register loads between B, C, D, E, (HL) and A
+	if (0x40 <= op && op <= 0x7F)
+		return op != 0x76 && dst != 4 && dst != 5;
+
+	// alu with a register or (HL)
+	if (0x80 <= op && op <= 0xBF)
+		return true;
+
+	// alu with an immediate
+	if (hi >= 0xC && src == 0b110)
+		return true;
+
+	switch (op)
+	{
+		case 0x00: case 0x07: case 0x0F: case 0x17: case 0x1F: case 0x27: case 0x2F: case 0x37: case 0x3F:
+		case 0x04: case 0x05: case 0x0C: case 0x0D: case 0x14: case 0x15: case 0x1C: case 0x1D: case 0x3C: case 0x3D:
+		case 0x34: case 0x35:
+		case 0x06: case 0x0E: case 0x16: case 0x1E: case 0x3E: case 0x36:
+		case 0x01: case 0x11: case 0x03: case 0x0B: case 0x13: case 0x1B:
+		case 0x22: case 0x2A: case 0x32: case 0x3A:
+			return true;
+	}
+
+	return false;
+}
+
+static u8 OperandBytes(u8 op)
+{
+	switch (op)
+	{
+		case 0x01: case 0x11:
+			return 2;
+		case 0x06: case 0x0E: case 0x16: case 0x1E: case 0x3E: case 0x36:
+			return 1;
+	}
+
+	return (op >> 6) == 0b11 ? 1 : 0;
+}
+
+static std::filesystem::path WriteSyntheticRom()
+{
+	std::vector<u8> rom(32KiB);
+
+	// entry point: nop; jp $0150
+	rom[0x100] = 0x00; rom[0x101] = 0xC3; rom[0x102] = 0x50; rom[0x103] = 0x01;
+	rom[0x147] = (u8)MapperType::ROM_ONLY;
+
+	// ld sp, $DFFE
+	u16 pc = 0x150;
+	for (u8 b : { 0x31, 0xFE, 0xDF })
+		rom[pc++] = b;
+
+	// loop: ld hl, $C000
+	u16 loop = pc;
+	for (u8 b : { 0x21, 0x00, 0xC0 })
+		rom[pc++] = b;
+
+	std::mt19937 rng(0x6A3B0);
+	for (int i = 0; i < 4096; i++)
+	{
+		if (rng() % 8 == 0)
+		{
+			// cb prefixed ops on anything but H and L
+			u8 cb;
+			do { cb = rng() % 256; } while ((cb & 0b111) == 4 || (cb & 0b111) == 5);
+			rom[pc++] = 0xCB;
+			rom[pc++] = cb;
+			continue;
+		}
+
+		u8 op;
+		do { op = rng() % 256; } while (!IsBenchmarkOpcode(op));
+		rom[pc++] = op;
+		for (int b = 0; b < OperandBytes(op); b++)
+			rom[pc++] = rng() % 256;
+	}
+
+	// jp loop
+	rom[pc++] = 0xC3;
+	rom[pc++] = loop & 0xFF;
+	rom[pc++] = loop >> 8;
+
+	auto path = std::filesystem::temp_directory_path() / "gambo_bench.gb";
+	std::ofstream file(path, std::ios::binary);
+	file.write((const char*)rom.data(), rom.size());
+	return path;
+}
+
+int main(int argc, char** argv)
+{
+	using clock = std::chrono::steady_clock;
+	using seconds = std::chrono::duration<double>;
+
+	std::filesystem::path romPath = argc > 1 && *argv[1] ? std::filesystem::path(argv[1]) : WriteSyntheticRom();
+	double duration = argc > 2 ? std::atof(argv[2]) : 3.0;
+	bool interpreter = argc > 3 && std::string_view(argv[3]) == "interpreter";
+
+	GamboCore gambo;
+	gambo.SetRandomSeed(0);
+	gambo.SetCPUBackend(interpreter ? CPUBackend::Interpreter : CPUBackend::Cached);
+	gambo.InsertCartridge(romPath);
+	if (!gambo.GetCartridge().IsMapperSupported())
+	{
+		std::fprintf(stderr, "could not load %s\n", romPath.string().c_str());
+		return 1;
+	}
+
+	// instructions per second
+	u64 instructions = 0;
+	auto start = clock::now();
+	while (seconds(clock::now() - start).count() < duration)
+	{
+		for (int i = 0; i < 100000; i++)
+			gambo.StepInstruction();
+
+		instructions += 100000;
+	}
+	double instructionTime = seconds(clock::now() - start).count();
+
+	// frames per second, including the ppu and input polling
+	u64 frames = 0;
+	start = clock::now();
+	while (seconds(clock::now() - start).count() < duration)
+	{
+		for (int i = 0; i < 10; i++)
+			gambo.RunFrame();
+
+		frames += 10;
+	}
+	double frameTime = seconds(clock::now() - start).count();
+
+	std::printf("%s (%s)\n", romPath.filename().string().c_str(), interpreter ? "interpreter" : "cached");
+	std::printf("  %.2f million instructions/s\n", instructions / instructionTime / 1e6);
+	std::printf("  %.1f frames/s (%.1fx real time)\n", frames / frameTime, frames / frameTime / 59.73);
+	return 0;
+}
@@ -0,0 +1,54 @@
+#include "BlockCache.h"
+
+Block* BlockCache::Find(u32 page, u16 addr) const
+{
+	if (!pages[page])
+		return nullptr;
+
+	return pages[page]->lookup[addr & 0x3FFF];
+}
+
+Block& BlockCache::Add(u32 page, u16 addr)
+{
+	if (!pages[page])
+		pages[page] = std::make_unique<Page>();
+
+	auto& p = *pages[page];
+	p.blocks.push_back(std::make_unique<Block>());
+	p.lookup[addr & 0x3FFF] = p.blocks.back().get();
+	return *p.blocks.back();
+}
+
+void BlockCache::MarkRamCode(u16 addr)
+{
+	// echo ram mirrors wram
+	if (0xE000 <= addr && addr <= 0xFDFF)
+		addr -= 0x2000;
+
+	ramCode.set(addr & 0x3FFF);
+}
+
+bool BlockCache::IsRamCode(u16 addr) const
+{
+	if (addr < 0xC000)
+		return false;
+
+	if (0xE000 <= addr && addr <= 0xFDFF)
+		addr -= 0x2000;
+
+	return ramCode.test(addr & 0x3FFF);
+}
+
+void BlockCache::InvalidateRam()
+{
+	pages[RamPage].reset();
+	ramCode.reset();
+}
+
+void BlockCache::Clear()
+{
+	for (auto& page : pages)
+		page.reset();
+
+	ramCode.reset();
+}
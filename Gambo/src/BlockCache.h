@@ -0,0 +1,55 @@
+#pragma once
+#include "GamboDefine.h"
+#include <bitset>
+#include <memory>
+
+// one instruction decoded ahead of time. operands are still read by the
+// handler, so only the opcode bytes need to stay valid.
+struct DecodedInstruction
+{
+	u16 addr;
+	u8 opcode;
+	bool isCB;
+};
+
+// straight line code starting at an address and ending at the first
+// instruction that can change the program counter.
+struct Block
+{
+	std::vector<DecodedInstruction> instructions;
+
+	// the block jumps back to its own start and only reads memory, so once a
+	// pass leaves the registers unchanged it will keep doing so until
+	// something outside the cpu changes what it reads
+	bool isIdleLoop = false;
+	bool mayReadTimer = false;	// reads DIV/TIMA or through a pointer that might point at them
+};
+
+// decoded blocks keyed by page (the rom bank the code was read from, or
+// RamPage for wram/hram) and the address inside that 16 KiB page. rom never
+// changes under a given bank, so rom blocks live until the cartridge changes.
+// ram blocks are thrown away as soon as one of their opcode bytes is written.
+class BlockCache
+{
+public:
+	static constexpr u32 RamPage = 0x200;
+	static constexpr int MaxBlockLength = 64;
+
+	Block* Find(u32 page, u16 addr) const;
+	Block& Add(u32 page, u16 addr);
+
+	void MarkRamCode(u16 addr);
+	bool IsRamCode(u16 addr) const;
+	void InvalidateRam();
+	void Clear();
+
+private:
+	struct Page
+	{
+		std::array<Block*, 16KiB> lookup{};
+		std::vector<std::unique_ptr<Block>> blocks;
+	};
+
+	std::array<std::unique_ptr<Page>, RamPage + 1> pages;
+	std::bitset<16KiB> ramCode;
+};
@@ -0,0 +1,134 @@
+#include "Breakpoints.h"
+#include "CPU.h"
+
+void Breakpoints::Add(const Breakpoint& b)
+{
+	breakpoints.push_back(b);
+	UpdatePages();
+}
+
+void Breakpoints::Remove(size_t index)
+{
+	if (index < breakpoints.size())
+		breakpoints.erase(breakpoints.begin() + index);
+
+	UpdatePages();
+}
+
+void Breakpoints::Clear()
+{
+	breakpoints.clear();
+	interruptMask = 0;
+	hit = {};
+	skipOnce = false;
+	UpdatePages();
+}
+
+const std::vector<Breakpoint>& Breakpoints::GetBreakpoints() const
+{
+	return breakpoints;
+}
+
+void Breakpoints::SetInterruptMask(u8 mask)
+{
+	interruptMask = mask;
+}
+
+u8 Breakpoints::GetInterruptMask() const
+{
+	return interruptMask;
+}
+
+bool Breakpoints::IsArmed() const
+{
+	return !breakpoints.empty() || interruptMask != 0;
+}
+
+void Breakpoints::CheckInterrupt(InterruptFlags f, u16 vector)
+{
+	if (interruptMask & f)
+		hit = { BreakReason::Interrupt, vector, (u8)f, -1 };
+}
+
+const BreakHit& Breakpoints::GetHit() const
+{
+	return hit;
+}
+
+void Breakpoints::ClearHit()
+{
+	hit = {};
+	skipOnce = false;
+}
+
+void Breakpoints::Continue(u16 pc)
+{
+	hit = {};
+	skipOnce = true;
+	skipPC = pc;
+}
+
+bool Breakpoints::Check(BreakKind kind, u16 addr, u8 value, const CPU& cpu)
+{
+	for (size_t i = 0; i < breakpoints.size(); i++)
+	{
+		auto& b = breakpoints[i];
+		if (!(b.kinds & (u8)kind) || addr < b.start || addr > b.end || !Passes(b.condition, cpu))
+			continue;
+
+		// the first one to fire is the one reported
+		if (!IsHit())
+		{
+			BreakReason reason = kind == BreakKind::Execute ? BreakReason::Execute
+				: kind == BreakKind::Read ? BreakReason::Read : BreakReason::Write;
+			hit = { reason, addr, value, (int)i };
+		}
+		return true;
+	}
+
+	return false;
+}
+
+bool Breakpoints::Passes(const BreakCondition& condition, const CPU& cpu)
+{
+	u16 v = 0;
+	switch (condition.reg)
+	{
+		case BreakRegister::None: return true;
+		case BreakRegister::A: v = cpu.GetA(); break;
+		case BreakRegister::F: v = cpu.GetF(); break;
+		case BreakRegister::B: v = cpu.GetB(); break;
+		case BreakRegister::C: v = cpu.GetC(); break;
+		case BreakRegister::D: v = cpu.GetD(); break;
+		case BreakRegister::E: v = cpu.GetE(); break;
+		case BreakRegister::H: v = cpu.GetH(); break;
+		case BreakRegister::L: v = cpu.GetL(); break;
+		case BreakRegister::AF: v = cpu.GetAF(); break;
+		case BreakRegister::BC: v = cpu.GetBC(); break;
+		case BreakRegister::DE: v = cpu.GetDE(); break;
+		case BreakRegister::HL: v = cpu.GetHL(); break;
+		case BreakRegister::SP: v = cpu.GetSP(); break;
+	}
+
+	switch (condition.compare)
+	{
+		case BreakCompare::Equal: return v == condition.value;
+		case BreakCompare::NotEqual: return v != condition.value;
+		case BreakCompare::Less: return v < condition.value;
+		case BreakCompare::LessEqual: return v <= condition.value;
+		case BreakCompare::Greater: return v > condition.value;
+		case BreakCompare::GreaterEqual: return v >= condition.value;
+	}
+
+	return true;
+}
+
+void Breakpoints::UpdatePages()
+{
+	pages.fill(0);
+	for (auto& b : breakpoints)
+	{
+		for (int page = b.start >> 8; page <= (b.end >> 8); page++)
+			pages[page] |= b.kinds;
+	}
+}
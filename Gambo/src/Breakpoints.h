@@ -0,0 +1,140 @@
+#pragma once
+#include "GamboDefine.h"
+
+class CPU;
+
+// what a breakpoint watches, any combination of these
+enum class BreakKind : u8
+{
+	Execute	= (1 << 0),	// pc lands on it
+	Read	= (1 << 1),
+	Write	= (1 << 2),
+};
+
+// register a condition looks at. None always passes.
+enum class BreakRegister : u8
+{
+	None,
+	A, F, B, C, D, E, H, L,
+	AF, BC, DE, HL, SP,
+};
+
+enum class BreakCompare : u8
+{
+	Equal,
+	NotEqual,
+	Less,
+	LessEqual,
+	Greater,
+	GreaterEqual,
+};
+
+// checked against the registers when the address matches
+struct BreakCondition
+{
+	BreakRegister reg = BreakRegister::None;
+	BreakCompare compare = BreakCompare::Equal;
+	u16 value = 0;
+};
+
+// a pc breakpoint is an execute watchpoint on a single address. io register
+// breaks are write watchpoints on the io range.
+struct Breakpoint
+{
+	u16 start = 0;
+	u16 end = 0;	// inclusive
+	u8 kinds = (u8)BreakKind::Execute;
+	BreakCondition condition;
+};
+
+enum class BreakReason : u8
+{
+	None,
+	Execute,
+	Read,
+	Write,
+	Interrupt,
+};
+
+struct BreakHit
+{
+	BreakReason reason = BreakReason::None;
+	u16 addr = 0;	// pc, the address accessed or the interrupt vector
+	u8 value = 0;	// the byte read or written
+	int index = -1;	// the breakpoint that fired, -1 for interrupts
+};
+
+// execute breakpoints stop in front of the instruction. memory watchpoints
+// and interrupts stop once the instruction or dispatch that set them off has
+// finished. the cpu only looks at any of this while something is armed, and
+// the memory map only sends pages with a watchpoint down the slow path.
+class Breakpoints
+{
+public:
+	void Add(const Breakpoint& b);
+	void Remove(size_t index);
+	void Clear();
+	const std::vector<Breakpoint>& GetBreakpoints() const;
+
+	// interrupts that break on dispatch, as InterruptFlags
+	void SetInterruptMask(u8 mask);
+	u8 GetInterruptMask() const;
+
+	bool IsArmed() const;
+
+	// BreakKind bits of every breakpoint touching each 256 byte page
+	const std::array<u8, 256>& GetPages() const
+	{
+		return pages;
+	}
+
+	bool CheckExecute(u16 pc, const CPU& cpu)
+	{
+		if (skipOnce)
+		{
+			// whatever runs next is past the instruction we stopped at
+			skipOnce = false;
+			if (pc == skipPC)
+				return false;
+		}
+
+		if (!(pages[pc >> 8] & (u8)BreakKind::Execute))
+			return false;
+
+		return Check(BreakKind::Execute, pc, 0, cpu);
+	}
+
+	void CheckAccess(BreakKind kind, u16 addr, u8 value, const CPU& cpu)
+	{
+		if (pages[addr >> 8] & (u8)kind)
+			Check(kind, addr, value, cpu);
+	}
+
+	void CheckInterrupt(InterruptFlags f, u16 vector);
+
+	bool IsHit() const
+	{
+		return hit.reason != BreakReason::None;
+	}
+
+	const BreakHit& GetHit() const;
+
+	void ClearHit();
+
+	// forgets the hit as well. an execute breakpoint at pc is let through once, so
+	// the instruction it stopped in front of gets to run.
+	void Continue(u16 pc);
+
+private:
+	bool Check(BreakKind kind, u16 addr, u8 value, const CPU& cpu);
+	static bool Passes(const BreakCondition& condition, const CPU& cpu);
+	void UpdatePages();
+
+	std::vector<Breakpoint> breakpoints;
+	std::array<u8, 256> pages{};
+	u8 interruptMask = 0;
+
+	BreakHit hit;
+	bool skipOnce = false;
+	u16 skipPC = 0;
+};
@@ -1,9 +1,27 @@
 #include "CPU.h"
 #include "GamboCore.h"
+#include "Cartridge.h"
+#include "InterruptController.h"
 #include "PPU.h"
 #include "RAM.h"
+#include "Trace.h"
+#include "Profiler.h"
+#include "Breakpoints.h"
+#include "SaveState.h"
 #include "spdlog/spdlog.h"
+#include <limits>
 
+// joypad, serial, timer, sound and lcd registers
+static constexpr bool IsIOAddress(u16 addr)
+{
+	return 0xFF00 <= addr && addr <= 0xFF7F;
+}
+
+// DIV, TIMA, TMA and TAC
+static constexpr bool IsTimerAddress(u16 addr)
+{
+	return HWAddr::DIV <= addr && addr <= HWAddr::TAC;
+}
 
 CPU::CPU(GamboCore* c)
 	: core(c)
@@ -17,36 +35,99 @@ CPU::~CPU()
 
 u8 CPU::Read(u16 addr)
 {
-	if ((core->ppu->IsEnabled()) && 
-		(
-			(core->ppu->GetMode() == PPUMode::OAMScan && (0xFE00 <= addr && addr <= 0xFE9F)) ||										// accessing oam during oam scan
-			(core->ppu->GetMode() == PPUMode::Draw && ((0xFE00 <= addr && addr <= 0xFE9F) || (0x8000 <= addr && addr <= 0x9FFF)))	// accessing oam or vram during drawing
-		)) 
-	{
-		return 0xFF;
-	}
-	else
+	if (const u8* page = core->memoryMap.GetReadPage(addr))
+		return page[addr & 0xFF];
+
+	u8 data = ReadSlow(addr);
+
+	// unwatched pages never get this far, they pay nothing for watchpoints
+	if (breakpoints)
+		breakpoints->CheckAccess(BreakKind::Read, addr, data, *this);
+
+	return data;
+}
+
+u8 CPU::Fetch(u16 addr)
+{
+	// opcode fetches don't count as reads for watchpoints
+	if (const u8* page = core->memoryMap.GetReadPage(addr))
+		return page[addr & 0xFF];
+
+	return ReadSlow(addr);
+}
+
+u8 CPU::ReadSlow(u16 addr)
+{
+	if (const u8* page = core->memoryMap.GetWatchedReadPage(addr))
+		return page[addr & 0xFF];
+
+	// io registers have to reflect everything up to this point
+	if (IsIOAddress(addr))
 	{
-		return core->Read(addr);
+		core->SyncComponents();
+		if (IsTimerAddress(addr))
+			SyncTimers();
 	}
+
+	return core->Read(addr);
 }
 
 void CPU::Write(u16 addr, u8 data)
 {
-	if ((core->ppu->IsEnabled()) && 
-		(
-			(core->ppu->GetMode() == PPUMode::OAMScan && (0xFE00 <= addr && addr <= 0xFE9F)) ||										// accessing oam during oam scan
-			(core->ppu->GetMode() == PPUMode::Draw && ((0xFE00 <= addr && addr <= 0xFE9F) || (0x8000 <= addr && addr <= 0x9FFF)))	// accessing oam or vram during drawing
-		)) 
+	u8* page = core->memoryMap.GetWritePage(addr);
+	if (!page && breakpoints)
 	{
+		breakpoints->CheckAccess(BreakKind::Write, addr, data, *this);
+		page = core->memoryMap.GetWatchedWritePage(addr);
+	}
+
+	if (page)
+	{
+		page[addr & 0xFF] = data;
+
+		// self modifying code
+		if (blockCache.IsRamCode(addr))
+		{
+			blockCache.InvalidateRam();
+			block = nullptr;
+			idleLoop = {};
+		}
 		return;
 	}
 
+	bool io = IsIOAddress(addr);
+	bool timer = IsTimerAddress(addr);
+	if (io)
+		core->SyncComponents();
+	if (timer)
+		SyncTimers();
+
     core->Write(addr, data);
 	if (addr == HWAddr::DMA)
 	{
 		core->ppu->SetDoDMATransfer(true);
 	}
+
+	// the ppu has to see this write at the end of the step it happened in
+	if (io)
+		core->RequestSync();
+
+	// the next overflow moves with any change to the timer
+	if (timer)
+		ScheduleTimer();
+
+	if (addr <= 0x7FFF || addr == HWAddr::BOOT)
+	{
+		// possibly a bank switch, the addresses in the current block may point at different code now
+		block = nullptr;
+	}
+	else if (blockCache.IsRamCode(addr))
+	{
+		// self modifying code
+		blockCache.InvalidateRam();
+		block = nullptr;
+		idleLoop = {};
+	}
 }
 
 u8& CPU::Get(u16 addr)
@@ -54,254 +135,134 @@ u8& CPU::Get(u16 addr)
 	return core->ram->Get(addr);
 }
 
-u8 CPU::RunFor(u8 ticks)
+int CPU::RunFor(int ticks)
+{
+	// tracing, profiling and breakpoints get their own copy of the loop, so
+	// none of it costs anything while it's all off
+	if (trace || profiler || breakpoints)
+		return Run<true>(ticks);
+
+	return Run<false>(ticks);
+}
+
+template<bool Debug>
+int CPU::Run(int ticks)
 {
 	int cycles = 0;
 
 	while (cycles < ticks)
 	{
+		int startCycles = cycles;
+
 		if (isHalted)
 		{
-			// count cycles as if NOP during halt
-			cycles += 4;
-
-			if (isHalted && InterruptPending())
+			if (core->interrupts->IsPending())
 			{
+				// count cycles as if NOP during halt
+				cycles += 4;
 				isHalted = false;
 			}
+			else
+			{
+				// nothing can wake us up before the next ppu or timer event, go straight there
+				cycles += GetHaltCycles();
+			}
 		}
 
 		bool handledInterrupt = false;
 
 		if (!isHalted)
 		{
-			if (IME && InterruptPending() && opcodeTimingDelay < 0)
+			if (IME && core->interrupts->IsPending() && microOp < 0)
 			{
-				handledInterrupt = HandleInterrupt(GetPendingInterrupt());
+				InterruptFlags f = core->interrupts->GetHighestPriority();
+				handledInterrupt = HandleInterrupt(f);
+
+				if constexpr (Debug)
+				{
+					if (profiler)
+						profiler->Interrupt(PC, SP);
+					if (breakpoints)
+						breakpoints->CheckInterrupt(f, PC);
+				}
 
 				// it takes 5 m-cycles just to dispatch the interrupt
 				cycles += 20;
 			}
 			else
 			{
-				if (opcodeTimingDelay < 0)
+				if (!Debug && microOp < 0 && block && block->isIdleLoop &&
+					blockIndex == block->instructions.size() && PC == block->instructions[0].addr)
 				{
-					opcodeTimingDelay = 0;
-					currentCycles = 0;
-					opcode = Read(PC++);
-					isCB = opcode == 0xCB;
-					
-#if defined(_DEBUG) && 0
-					std::string s = "$" + hex(PC - 1, 4) + ": ";
-					if (opcode == 0xCB)
+					if (int idle = SkipIdleLoop(core->scheduler.GetNow() + cycles))
 					{
-						u8 cbOpcode = Read(PC);
-						s += instructions16bit[cbOpcode].mnemonic;
-					}
-					else
-					{
-						auto& instruction = instructions8bit[opcode];
-						switch (instruction.bytes)
-						{
-							case 0:
-							case 1:
-							{
-								s += instruction.mnemonic;
-								break;
-							}
-							case 2:
-							{
-								u8 data = Read(PC);
-								std::string firstTwoChar(instruction.mnemonic.begin(), instruction.mnemonic.begin() + 2);
-								if (firstTwoChar == "JR")
-								{
-									s16 sdata = (s8)data;
-									sdata += PC + 1;
-									s += std::vformat(instruction.mnemonic, std::make_format_args(hex(sdata, 4)));
-									break;
-								}
-								s += std::vformat(instruction.mnemonic, std::make_format_args(hex(data, 2)));
-								break;
-							}
-							case 3:
-							{
-								u16 lo = Read(PC);
-								u16 hi = Read(PC + 1);
-								u16 data = (hi << 8) | lo;
-								s += std::vformat(instruction.mnemonic, std::make_format_args(hex(data, 4)));
-								break;
-							}
-							default:
-								throw("opcode has more than 3 bytes");
-						}
-					}
-					spdlog::debug(s);
-#endif
-
-					if (haltBug)
-					{
-						haltBug = false;
-						PC--;
-					}
-
-					// timing for non cb instructions
-					switch (opcode)
-					{
-						case 0x34:
-						case 0x35:
-						case 0x36:
-						case 0xE0:
-						case 0xF0:
-						{
-							opcodeTimingDelay = 1;
-							break;
-						}
-						case 0xEA:
-						case 0xFA:
-						{
-							opcodeTimingDelay = 2;
-							break;
-						}
+						cycles += idle;
+						continue;
 					}
 				}
-				
 
-				
-				if (isCB)
+				if (microOp < 0)
 				{
-					if (opcode == 0xCB)
+					if constexpr (Debug)
 					{
-						opcode = Read(PC++);
-
-						// halt bug applies to both bytes
-						if (haltBug)
+						if (breakpoints && breakpoints->CheckExecute(PC, *this))
 						{
-							haltBug = false;
-							PC--;
+							// stop in front of the instruction
+							if (profiler)
+								profiler->AddCycles(cycles - startCycles);
+							break;
 						}
 
-						// timing for CB instructinos
-						switch (opcode)
-						{
-							case 0x46:
-							case 0x4E:
-							case 0x56:
-							case 0x5E:
-							case 0x66:
-							case 0x6E:
-							case 0x76:
-							case 0x7E:
-							{
-								opcodeTimingDelay = 1;
-								break;
-							}
-							case 0x06:
-							case 0x0E:
-							case 0x16:
-							case 0x1E:
-							case 0x26:
-							case 0x2E:
-							case 0x36:
-							case 0x3E:
-							case 0x86:
-							case 0x8E:
-							case 0x96:
-							case 0x9E:
-							case 0xA6:
-							case 0xAE:
-							case 0xB6:
-							case 0xBE:
-							case 0xC6:
-							case 0xCE:
-							case 0xD6:
-							case 0xDE:
-							case 0xE6:
-							case 0xEE:
-							case 0xF6:
-							case 0xFE:
-							{
-								opcodeTimingDelay = 2;
-								break;
-							}
-						}
+						if (trace)
+							RecordTrace(cycles);
+						if (profiler)
+							profiler->BeginInstruction(PC, SP);
 					}
 
-					opcodeTable = &instructions16bit;
-				}
-				else
-				{
-					opcodeTable = &instructions8bit;
+					microOp = 0;
+					currentCycles = 0;
+					if (haltBug || backend == CPUBackend::Interpreter || !FetchDecoded())
+						FetchOpcode();
+
+					schedule = &GetSchedule();
 				}
 
-				switch (opcodeTimingDelay)
+				switch (schedule->microOps[microOp])
 				{
-					// using the default case allows us to delay by any arbitrary amount
-					default:
+					case MicroOp::Internal:
 					{
-						// throw if the delay is negative somehow. this should never happen
-						if (opcodeTimingDelay < 0)
-							throw;
-
-						// reads for these happen on the second to last m-cycle cycle. writes 
-						// happen on the last cycle.
-						if (isCB)
-						{
-							if (opcodeTimingDelay == 1 && (
-								opcode == 0x06 || 
-								opcode == 0x0E || 
-								opcode == 0x16 || 
-								opcode == 0x1E || 
-								opcode == 0x26 || 
-								opcode == 0x2E || 
-								opcode == 0x36 || 
-								opcode == 0x3E || 
-								opcode == 0x86 || 
-								opcode == 0x8E || 
-								opcode == 0x96 || 
-								opcode == 0x9E || 
-								opcode == 0xA6 || 
-								opcode == 0xAE || 
-								opcode == 0xB6 || 
-								opcode == 0xBE || 
-								opcode == 0xC6 || 
-								opcode == 0xCE || 
-								opcode == 0xD6 || 
-								opcode == 0xDE || 
-								opcode == 0xE6 || 
-								opcode == 0xEE || 
-								opcode == 0xF6 || 
-								opcode == 0xFE))
-							{
-								(this->*(*opcodeTable)[opcode].Execute)();
-							}
-						}
-						else
-						{
-							if (opcodeTimingDelay == 1 && (
-								opcode == 0x34 ||
-								opcode == 0x35))
-							{
-								(this->*(*opcodeTable)[opcode].Execute)();
-							}
-						}
-
-						// add one m-cycle and set delay to the next lowest state
 						cycles += 4;
 						currentCycles += 4;
-						opcodeTimingDelay--;
+						microOp++;
+						break;
+					}
+					case MicroOp::ReadHL:
+					{
+						// read-modify-write instructions read on the second to last m-cycle
+						// and write on the last
+						hlData = Read(HL);
+						cycles += 4;
+						currentCycles += 4;
+						microOp++;
 						break;
 					}
-					case 0:
+					case MicroOp::Execute:
 					{
 						// figure out the cycles remaining. for any opcode that is NOT delayed, 
 						// this should be equal to whatever is in the opcode table
-						currentCycles = (*opcodeTable)[opcode].cycles - currentCycles;
+						currentCycles = GetInstruction().cycles - currentCycles;
 
 						// execute the instruction and see if we require additional clock cycles
-						currentCycles += (this->*(*opcodeTable)[opcode].Execute)();
+						currentCycles += ExecuteOpcode();
 
 						cycles += currentCycles;
-						opcodeTimingDelay--;
+						microOp = -1;
+
+						if constexpr (Debug)
+						{
+							if (profiler)
+								profiler->EndInstruction(opcode, isCB, PC, SP);
+						}
 						break;
 					}
 				}
@@ -316,17 +277,404 @@ u8 CPU::RunFor(u8 ticks)
 				IME = true;
 			}
 		}
+
+		if constexpr (Debug)
+		{
+			if (profiler)
+				profiler->AddCycles(cycles - startCycles);
+
+			// watchpoints and interrupts stop once the instruction is done
+			if (breakpoints && microOp < 0 && breakpoints->IsHit())
+				break;
+		}
 	}
 
-	UpdateTimers(cycles);
 	return cycles;
 }
 
+void CPU::FetchOpcode()
+{
+	block = nullptr;
+	opcode = Fetch(PC++);
+	isCB = opcode == 0xCB;
+
+
+	if (haltBug)
+	{
+		haltBug = false;
+		PC--;
+	}
+
+	if (isCB)
+	{
+		opcode = Fetch(PC++);
+
+		// halt bug applies to both bytes
+		if (haltBug)
+		{
+			haltBug = false;
+			PC--;
+		}
+	}
+}
+
+// anything that can move the program counter somewhere other than the next instruction
+static constexpr bool EndsBlock(u8 opcode)
+{
+	switch (opcode)
+	{
+		case 0x10: // STOP
+		case 0x18: case 0x20: case 0x28: case 0x30: case 0x38: // JR
+		case 0x76: // HALT
+		case 0xC2: case 0xC3: case 0xCA: case 0xD2: case 0xDA: case 0xE9: // JP
+		case 0xC4: case 0xCC: case 0xCD: case 0xD4: case 0xDC: // CALL
+		case 0xC0: case 0xC8: case 0xC9: case 0xD0: case 0xD8: case 0xD9: // RET
+		case 0xC7: case 0xCF: case 0xD7: case 0xDF: case 0xE7: case 0xEF: case 0xF7: case 0xFF: // RST
+			return true;
+	}
+
+	return false;
+}
+
+void CPU::SetBackend(CPUBackend b)
+{
+	backend = b;
+	block = nullptr;
+}
+
+CPUBackend CPU::GetBackend() const
+{
+	return backend;
+}
+
+void CPU::SetTrace(TraceBuffer* t)
+{
+	trace = t;
+}
+
+void CPU::SetProfiler(Profiler* p)
+{
+	profiler = p;
+}
+
+void CPU::SetBreakpoints(Breakpoints* b)
+{
+	breakpoints = b;
+}
+
+void CPU::RecordTrace(int cycles)
+{
+	TraceEntry entry = {};
+	entry.cycle = core->scheduler.GetNow() + cycles;
+	entry.PC = PC;
+	entry.SP = SP;
+
+	if (PC <= 0x7FFF && core->cart->IsLoaded() && !core->IsBootRomAddress(PC))
+		entry.bank = core->cart->GetRomOffset(PC) >> 14;
+
+	entry.A = A;
+	entry.F = ComputeFlags();
+	entry.B = B;
+	entry.C = C;
+	entry.D = D;
+	entry.E = E;
+	entry.H = H;
+	entry.L = L;
+	entry.IME = IME;
+
+	// peek without the side effects of a cpu read
+	for (u16 i = 0; i < entry.pcmem.size(); i++)
+	{
+		u16 addr = PC + i;
+		const u8* page = core->memoryMap.GetReadPage(addr);
+		entry.pcmem[i] = page ? page[addr & 0xFF] : core->Read(addr);
+	}
+
+	trace->Record(entry);
+}
+
+bool CPU::FetchDecoded()
+{
+	// carry on through the block we're in unless something jumped out of it
+	if (!block || blockIndex >= block->instructions.size() || block->instructions[blockIndex].addr != PC)
+	{
+		u32 page;
+		if (!GetBlockPage(PC, page))
+			return false;
+
+		block = blockCache.Find(page, PC);
+		if (!block)
+			block = &BuildBlock(page, PC);
+
+		blockIndex = 0;
+	}
+
+	auto& instruction = block->instructions[blockIndex++];
+	opcode = instruction.opcode;
+	isCB = instruction.isCB;
+	PC += isCB ? 2 : 1;
+	return true;
+}
+
+bool CPU::GetBlockPage(u16 addr, u32& page)
+{
+	// the last byte of each region is left to the slow path so a cb opcode
+	// never straddles two of them
+	if (addr <= 0x7FFF && (addr & 0x3FFF) != 0x3FFF)
+	{
+		if (!core->cart->IsLoaded() || core->IsBootRomAddress(addr))
+			return false;
+
+		page = core->cart->GetRomOffset(addr) >> 14;
+		return page < BlockCache::RamPage;
+	}
+
+	if ((0xC000 <= addr && addr < 0xDFFF) || (0xFF80 <= addr && addr < 0xFFFE))
+	{
+		page = BlockCache::RamPage;
+		return true;
+	}
+
+	// vram, cartridge ram, echo ram and io aren't worth caching
+	return false;
+}
+
+const Block& CPU::BuildBlock(u32 page, u16 addr)
+{
+	Block& newBlock = blockCache.Add(page, addr);
+	u16 start = addr;
+
+	while (newBlock.instructions.size() < BlockCache::MaxBlockLength)
+	{
+		DecodedInstruction decoded;
+		decoded.addr = addr;
+		decoded.opcode = Read(addr);
+		decoded.isCB = decoded.opcode == 0xCB;
+		if (decoded.isCB)
+			decoded.opcode = Read(addr + 1);
+
+		newBlock.instructions.push_back(decoded);
+
+		// writes to these bytes have to throw the block away
+		if (page == BlockCache::RamPage)
+		{
+			blockCache.MarkRamCode(addr);
+			if (decoded.isCB)
+				blockCache.MarkRamCode(addr + 1);
+		}
+
+		u8 length = decoded.isCB ? 2 : instructions8bit[decoded.opcode].bytes;
+		if (length == 0 || (!decoded.isCB && EndsBlock(decoded.opcode)))
+			break;
+
+		// stop where the region we started in ends
+		u16 next = addr + length;
+		u32 nextPage;
+		if ((next & 0xC000) != (start & 0xC000) || !GetBlockPage(next, nextPage) || nextPage != page)
+			break;
+
+		addr = next;
+	}
+
+	MarkIdleLoop(newBlock);
+	return newBlock;
+}
+
+// instructions that change nothing but registers and flags. memory is only read.
+static constexpr bool IsReadOnly(const DecodedInstruction& i)
+{
+	if (i.isCB)
+		return (i.opcode & 0b111) != 6 || (0x40 <= i.opcode && i.opcode <= 0x7F); // (HL) is only safe for BIT
+
+	u8 op = i.opcode;
+	if (0x40 <= op && op <= 0x7F)
+		return op < 0x70 || op > 0x77; // not LD (HL),r or HALT
+
+	if (0x80 <= op && op <= 0xBF)
+		return true;
+
+	switch (op)
+	{
+		case 0x00:
+		case 0x01: case 0x11: case 0x21:
+		case 0x03: case 0x13: case 0x23: case 0x0B: case 0x1B: case 0x2B:
+		case 0x04: case 0x0C: case 0x14: case 0x1C: case 0x24: case 0x2C: case 0x3C:
+		case 0x05: case 0x0D: case 0x15: case 0x1D: case 0x25: case 0x2D: case 0x3D:
+		case 0x06: case 0x0E: case 0x16: case 0x1E: case 0x26: case 0x2E: case 0x3E:
+		case 0x07: case 0x0F: case 0x17: case 0x1F: case 0x27: case 0x2F: case 0x37: case 0x3F:
+		case 0x09: case 0x19: case 0x29: case 0x39:
+		case 0x0A: case 0x1A: case 0x2A: case 0x3A: case 0xF2: case 0xF0: case 0xFA:
+		case 0xC6: case 0xCE: case 0xD6: case 0xDE: case 0xE6: case 0xEE: case 0xF6: case 0xFE:
+			return true;
+	}
+
+	return false;
+}
+
+// anything reading through a register pointer might be reading DIV or TIMA
+static constexpr bool MayReadTimer(const DecodedInstruction& i, u16 operand)
+{
+	if (i.isCB)
+		return (i.opcode & 0b111) == 6;
+
+	u8 op = i.opcode;
+	if (0x40 <= op && op <= 0xBF)
+		return (op & 0b111) == 6;
+
+	switch (op)
+	{
+		case 0x0A: case 0x1A: case 0x2A: case 0x3A: case 0xF2:
+			return true;
+		case 0xF0:
+			return (u8)operand == (u8)HWAddr::DIV || (u8)operand == (u8)HWAddr::TIMA;
+		case 0xFA:
+			return operand == HWAddr::DIV || operand == HWAddr::TIMA;
+	}
+
+	return false;
+}
+
+void CPU::MarkIdleLoop(Block& b)
+{
+	// looking for a loop that polls memory until something changes it, e.g.
+	// ldh a,(LY); cp $90; jr nz,loop
+	auto& last = b.instructions.back();
+	if (last.isCB)
+		return;
+
+	u16 start = b.instructions[0].addr;
+	u16 target;
+	switch (last.opcode)
+	{
+		case 0x18: case 0x20: case 0x28: case 0x30: case 0x38:
+			target = last.addr + 2 + (s8)Read(last.addr + 1);
+			break;
+		case 0xC2: case 0xC3: case 0xCA: case 0xD2: case 0xDA:
+			target = Read(last.addr + 1) | (Read(last.addr + 2) << 8);
+			break;
+		default:
+			return;
+	}
+
+	if (target != start)
+		return;
+
+	for (size_t i = 0; i + 1 < b.instructions.size(); i++)
+	{
+		auto& instruction = b.instructions[i];
+		if (!IsReadOnly(instruction))
+			return;
+
+		// DIV and TIMA tick between events, a loop reading them only stays idle until the next tick
+		u16 operand = Read(instruction.addr + 1) | (Read(instruction.addr + 2) << 8);
+		b.mayReadTimer |= MayReadTimer(instruction, operand);
+	}
+
+	b.isIdleLoop = true;
+}
+
+// expands to one case per opcode. indexing the constexpr tables with a
+// constant lets the compiler resolve every handler at compile time.
+#define OPCODE_CASE(table, n) case (n): return (this->*table[n].Execute)();
+#define OPCODE_CASES_16(table, n) \
+	OPCODE_CASE(table, n + 0x0) OPCODE_CASE(table, n + 0x1) OPCODE_CASE(table, n + 0x2) OPCODE_CASE(table, n + 0x3) \
+	OPCODE_CASE(table, n + 0x4) OPCODE_CASE(table, n + 0x5) OPCODE_CASE(table, n + 0x6) OPCODE_CASE(table, n + 0x7) \
+	OPCODE_CASE(table, n + 0x8) OPCODE_CASE(table, n + 0x9) OPCODE_CASE(table, n + 0xA) OPCODE_CASE(table, n + 0xB) \
+	OPCODE_CASE(table, n + 0xC) OPCODE_CASE(table, n + 0xD) OPCODE_CASE(table, n + 0xE) OPCODE_CASE(table, n + 0xF)
+#define OPCODE_CASES_256(table) \
+	OPCODE_CASES_16(table, 0x00) OPCODE_CASES_16(table, 0x10) OPCODE_CASES_16(table, 0x20) OPCODE_CASES_16(table, 0x30) \
+	OPCODE_CASES_16(table, 0x40) OPCODE_CASES_16(table, 0x50) OPCODE_CASES_16(table, 0x60) OPCODE_CASES_16(table, 0x70) \
+	OPCODE_CASES_16(table, 0x80) OPCODE_CASES_16(table, 0x90) OPCODE_CASES_16(table, 0xA0) OPCODE_CASES_16(table, 0xB0) \
+	OPCODE_CASES_16(table, 0xC0) OPCODE_CASES_16(table, 0xD0) OPCODE_CASES_16(table, 0xE0) OPCODE_CASES_16(table, 0xF0)
+
+u8 CPU::ExecuteOpcode()
+{
+	if (isCB)
+	{
+		switch (opcode)
+		{
+			OPCODE_CASES_256(instructions16bit)
+		}
+	}
+	else
+	{
+		switch (opcode)
+		{
+			OPCODE_CASES_256(instructions8bit)
+		}
+	}
+
+	return 0;
+}
+
+#undef OPCODE_CASES_256
+#undef OPCODE_CASES_16
+#undef OPCODE_CASE
+
+const CPU::CPUInstruction& CPU::GetInstruction() const
+{
+	return isCB ? instructions16bit[opcode] : instructions8bit[opcode];
+}
+
+static constexpr OpcodeSchedule MakeSchedule(bool isCB, u8 opcode)
+{
+	using enum MicroOp;
+
+	if (isCB)
+	{
+		// only the (HL) forms touch memory after the fetch
+		if ((opcode & 0b111) != 0b110)
+			return { Execute };
+
+		// BIT only reads, on its last m-cycle. everything else reads on the
+		// second to last and writes on the last.
+		if (0x40 <= opcode && opcode <= 0x7F)
+			return { Internal, Execute };
+
+		return { Internal, ReadHL, Execute };
+	}
+
+	switch (opcode)
+	{
+		case 0x34:	// INC (HL)
+		case 0x35:	// DEC (HL)
+			return { ReadHL, Execute };
+
+		case 0x36:	// LD (HL), d8
+		case 0xE0:	// LD (FF00+a8), A
+		case 0xF0:	// LD A, (FF00+a8)
+			return { Internal, Execute };
+
+		case 0xEA:	// LD (a16), A
+		case 0xFA:	// LD A, (a16)
+			return { Internal, Internal, Execute };
+	}
+
+	return { Execute };
+}
+
+static constexpr auto OpcodeSchedules = []()
+{
+	// 8 bit opcodes first, then the cb prefixed ones
+	std::array<OpcodeSchedule, 512> schedules{};
+	for (int i = 0; i < 256; i++)
+	{
+		schedules[i] = MakeSchedule(false, (u8)i);
+		schedules[256 + i] = MakeSchedule(true, (u8)i);
+	}
+	return schedules;
+}();
+
+const OpcodeSchedule& CPU::GetSchedule() const
+{
+	return OpcodeSchedules[(isCB ? 256 : 0) + opcode];
+}
+
 #pragma warning(push)
 #pragma warning(disable: 26813)
 void CPU::RequestInterrupt(InterruptFlags f)
 {
-	Write(HWAddr::IF, Read(HWAddr::IF) | f);
+	core->interrupts->Request(f);
 }
 #pragma warning(pop)
 
@@ -335,9 +683,15 @@ bool CPU::HandleInterrupt(InterruptFlags f)
 
 	// disable interrupts
 	IME = false;
+	idleLoop = {};
+
+	// the ppu has to be caught up before the flag is cleared, it could set it
+	// again on the cycles it hasn't run yet
+	core->SyncComponents();
+	core->RequestSync();
 
 	// acknowledge the interrupt by clearing its flag
-	Get(HWAddr::IF) &= ~(f);
+	core->interrupts->Acknowledge(f);
 
 	// push the program counter so we can get back to 
 	// where we left off
@@ -373,14 +727,35 @@ bool CPU::HandleInterrupt(InterruptFlags f)
 	return true;
 }
 
-void CPU::UpdateTimers(u8 ticks)
+void CPU::SyncTimers()
 {
-	// DIV register always counts up every 256 clock cycles
-	if ((DIVCounter += ticks) >= 256)
+	u64 now = core->scheduler.GetNow();
+	int ticks = (int)(now - timersSyncedTo);
+	timersSyncedTo = now;
+
+	if (ticks > 0)
 	{
-		DIVCounter -= 256;
-		Get(HWAddr::DIV)++; // set directly to prevent reset from Write() logic
+		UpdateTimers(ticks);
+		ScheduleTimer();
 	}
+}
+
+void CPU::ScheduleTimer()
+{
+	int cycles = GetCyclesUntilTimerEvent(false);
+	if (cycles == std::numeric_limits<int>::max())
+		core->scheduler.Cancel(SchedulerEvent::Timer);
+	else
+		core->scheduler.Schedule(SchedulerEvent::Timer, timersSyncedTo + cycles);
+}
+
+void CPU::UpdateTimers(int ticks)
+{
+	// DIV register always counts up every 256 clock cycles. ticks can span
+	// many of those, so work out the increments instead of counting them.
+	DIVCounter += ticks;
+	Get(HWAddr::DIV) += (u8)(DIVCounter / 256); // set directly to prevent reset from Write() logic
+	DIVCounter %= 256;
 
 	// if TIMA is enabled
 	u8& TAC = Get(HWAddr::TAC);
@@ -409,78 +784,156 @@ void CPU::UpdateTimers(u8 ticks)
 
 		u8& TIMA = Get(HWAddr::TIMA);
 		TIMACounter += ticks;
-		while (TIMACounter >= TIMAFreq)
+		int increments = TIMACounter / TIMAFreq;
+		TIMACounter %= TIMAFreq;
+
+		while (increments > 0)
 		{
-			TIMACounter -= TIMAFreq;
 			if (TIMA == 0xFF)
 			{
 				// TIMA resets to TMA register value
-				TIMA = Read(HWAddr::TMA);
+				TIMA = Get(HWAddr::TMA);
 				RequestInterrupt(InterruptFlags::Timer);
+				increments--;
 			}
 			else
-				TIMA++;
+			{
+				int steps = std::min(increments, 0xFF - TIMA);
+				TIMA += (u8)steps;
+				increments -= steps;
+			}
 		}
 	}
 }
 
-bool CPU::InterruptPending()
+int CPU::GetCyclesUntilTimerEvent(bool ticks)
+{
+	// cycles until TIMA overflows. with ticks every DIV and TIMA increment counts as well.
+	int cycles = ticks ? 256 - DIVCounter : std::numeric_limits<int>::max();
+
+	u8 TAC = Get(HWAddr::TAC);
+	if (TAC & 0b100)
+	{
+		static constexpr int TIMAFreqs[] = { 1024, 16, 64, 256 };
+		int TIMAFreq = TIMAFreqs[TAC & 0b011];
+		int untilTick = TIMAFreq - TIMACounter;
+		cycles = std::min(cycles, ticks ? untilTick : untilTick + (0xFF - Get(HWAddr::TIMA)) * TIMAFreq);
+	}
+
+	return cycles;
+}
+
+int CPU::GetCyclesUntilEvent(bool timerTicks)
+{
+	// cycles until the ppu or timer can raise an interrupt. they have to be
+	// caught up first for their counters to mean anything.
+	core->SyncComponents();
+	SyncTimers();
+	return std::min(core->ppu->GetCyclesUntilEvent(), GetCyclesUntilTimerEvent(timerTicks));
+}
+
+int CPU::GetHaltCycles()
+{
+	// the ime delay counts down every 4 cycle step, don't skip over it
+	if (IMEcycles > 0)
+		return 4;
+
+	// halt runs in 4 cycle steps. stop at the step the event lands in, the
+	// interrupt it raises is picked up on the next call just like before.
+	return std::max(4, (GetCyclesUntilEvent(false) + 3) & ~3);
+}
+
+int CPU::SkipIdleLoop(u64 now)
+{
+	// called each time an idle loop candidate jumps back to its start
+	int cyclesUntilEvent = GetCyclesUntilEvent(block->mayReadTimer);
+	u16 af = GetAF();
+
+	if (idleLoop.block == block && IMEcycles == 0 &&
+		idleLoop.AF == af && idleLoop.BC == BC && idleLoop.DE == DE && idleLoop.HL == HL)
+	{
+		// the last pass saw nothing change and ended where it started. every
+		// pass until the next event will read the same values and do the same,
+		// so run them all at once. stop short of the pass the event lands in.
+		int pass = (int)(now - idleLoop.cycleCount);
+		if (pass > 0 && pass < idleLoop.cyclesUntilEvent)
+		{
+			int passes = (cyclesUntilEvent - 1) / pass;
+			if (passes > 0)
+			{
+				idleLoop.block = nullptr;
+				return passes * pass;
+			}
+		}
+	}
+
+	idleLoop = { block, af, BC, DE, HL, now, cyclesUntilEvent };
+	return 0;
+}
+
+void CPU::ADD(const u8 data)
+{
+	u16 sum = A + data;
+	SetLazyFlags(FlagOp::Add, A, data, sum);
+	A = (u8)sum;
+}
+
+void CPU::ADC(const u8 data)
+{
+	u16 sum = A + data + GetFlag(CPUFlags::C);
+	SetLazyFlags(FlagOp::Add, A, data, sum);
+	A = (u8)sum;
+}
+
+void CPU::SUB(const u8 data)
+{
+	u16 diff = A - data;
+	SetLazyFlags(FlagOp::Sub, A, data, diff);
+	A = (u8)diff;
+}
+
+void CPU::SBC(const u8 data)
 {
-	u8 IE = Read(HWAddr::IE);
-	u8 IF = Read(HWAddr::IF);
-	return (IE & IF & 0b11111) != 0;
+	u16 diff = A - data - GetFlag(CPUFlags::C);
+	SetLazyFlags(FlagOp::Sub, A, data, diff);
+	A = (u8)diff;
 }
 
-InterruptFlags CPU::GetPendingInterrupt()
+void CPU::AND(const u8 data)
 {
-	u8 IE = Read(HWAddr::IE);
-	u8 IF = Read(HWAddr::IF);
-	u8 IE_IF = IE & IF;
-
-	if (IE_IF & InterruptFlags::VBlank)
-		return InterruptFlags::VBlank;
-
-	if (IE_IF & InterruptFlags::LCDStat)
-		return InterruptFlags::LCDStat;
-
-	if (IE_IF & InterruptFlags::Timer)
-		return InterruptFlags::Timer;
-
-	if (IE_IF & InterruptFlags::Serial)
-		return InterruptFlags::Serial;
-
-	if (IE_IF & InterruptFlags::Joypad)
-		return InterruptFlags::Joypad;
-
-	return InterruptFlags::None;
+	A &= data;
+	SetLazyFlags(FlagOp::And, 0, 0, A);
 }
 
-void CPU::ADC(const u8 data)
+void CPU::XOR(const u8 data)
 {
-	int carry = GetFlag(CPUFlags::C);
-
-	int sum = A + data + carry;
-
-	SetFlag(CPUFlags::N, 0);
-	SetFlag(CPUFlags::H, ((A & 0xF) + (data & 0xF) + carry) > 0xF);
-	SetFlag(CPUFlags::C, sum > 0xFF);
-
-	A = (u8)sum;
-	SetFlag(CPUFlags::Z, A == 0);
+	A ^= data;
+	SetLazyFlags(FlagOp::Or, 0, 0, A);
 }
 
-void CPU::SBC(const u8 data)
+void CPU::OR(const u8 data)
 {
-	int carry = GetFlag(CPUFlags::C);
+	A |= data;
+	SetLazyFlags(FlagOp::Or, 0, 0, A);
+}
 
-	int sum = A - data - carry;
+void CPU::CP(const u8 data)
+{
+	SetLazyFlags(FlagOp::Sub, A, data, A - data);
+}
 
-	SetFlag(CPUFlags::N, 1);
-	SetFlag(CPUFlags::H, ((A & 0xF) - (data & 0xF) - carry) < 0);
-	SetFlag(CPUFlags::C, sum < 0);
+void CPU::INC(u8& reg)
+{
+	u16 carry = GetFlag(CPUFlags::C) << 8;
+	reg++;
+	SetLazyFlags(FlagOp::Inc, 0, 0, carry | reg);
+}
 
-	A = (u8)sum;
-	SetFlag(CPUFlags::Z, A == 0);
+void CPU::DEC(u8& reg)
+{
+	u16 carry = GetFlag(CPUFlags::C) << 8;
+	reg--;
+	SetLazyFlags(FlagOp::Dec, 0, 0, carry | reg);
 }
 
 void CPU::BIT(u8& reg, int bit)
@@ -490,6 +943,67 @@ void CPU::BIT(u8& reg, int bit)
 	SetFlag(CPUFlags::N, 0);
 }
 
+void CPU::SaveState(StateWriter& w) const
+{
+	// the lazy flags are worked out, states always have F up to date
+	w.Write(A);
+	w.Write(ComputeFlags());
+	w.Write(BC);
+	w.Write(DE);
+	w.Write(HL);
+	w.Write(SP);
+	w.Write(PC);
+	w.Write(stopMode);
+	w.Write(isHalted);
+	w.Write(haltBug);
+	w.Write(unhaltCycles);
+	w.Write(currentCycles);
+	w.Write(microOp);
+	w.Write(hlData);
+	w.Write(opcode);
+	w.Write(isCB);
+	w.Write(instructionComplete);
+	w.Write(IME);
+	w.Write(IMEcycles);
+	w.Write(DIVCounter);
+	w.Write(TIMACounter);
+	w.Write(timersSyncedTo);
+}
+
+void CPU::LoadState(StateReader& r)
+{
+	r.Read(A);
+	r.Read(F);
+	r.Read(BC);
+	r.Read(DE);
+	r.Read(HL);
+	r.Read(SP);
+	r.Read(PC);
+	r.Read(stopMode);
+	r.Read(isHalted);
+	r.Read(haltBug);
+	r.Read(unhaltCycles);
+	r.Read(currentCycles);
+	r.Read(microOp);
+	r.Read(hlData);
+	r.Read(opcode);
+	r.Read(isCB);
+	r.Read(instructionComplete);
+	r.Read(IME);
+	r.Read(IMEcycles);
+	r.Read(DIVCounter);
+	r.Read(TIMACounter);
+	r.Read(timersSyncedTo);
+	lazyFlags = {};
+	schedule = &GetSchedule();
+
+	// rom blocks are still good, it's the same cartridge. the code in ram may not be.
+	blockCache.InvalidateRam();
+	block = nullptr;
+	blockIndex = 0;
+	idleLoop = {};
+}
+
 void CPU::Reset()
 {
 	stopMode = false;
@@ -497,15 +1011,21 @@ void CPU::Reset()
 	haltBug = false;
 	unhaltCycles = 0;
 	currentCycles = 0;
-	opcodeTimingDelay = 0;
+	hlData = 0;
 	opcode = 0;
 	isCB = false;
+	microOp = 0;
+	schedule = &GetSchedule();
 	instructionComplete = true;
-	opcodeTable = &instructions8bit;
 	IME = false;
 	IMEcycles = false;
 	DIVCounter = 0;
 	TIMACounter = 0;
+	timersSyncedTo = 0;
+	blockCache.Clear();
+	block = nullptr;
+	blockIndex = 0;
+	idleLoop = {};
 
 	if (core->IsUseBootRom())
 	{
@@ -546,9 +1066,9 @@ const u8& CPU::GetA() const
 	return A;
 }
 
-const u8& CPU::GetF() const
+u8 CPU::GetF() const
 {
-	return F;
+	return ComputeFlags();
 }
 
 const u8& CPU::GetB() const
@@ -581,9 +1101,9 @@ const u8& CPU::GetL() const
 	return L;
 }
 
-const u16& CPU::GetAF() const
+u16 CPU::GetAF() const
 {
-	return AF;
+	return (A << 8) | ComputeFlags();
 }
 
 const u16& CPU::GetBC() const
@@ -613,95 +1133,98 @@ const u16& CPU::GetPC() const
 
 void CPU::SetFlag(CPUFlags f, bool v)
 {
+	MaterializeFlags();
+
 	if (v)
 		F |= (u8)f;
 	else
 		F &= ~(u8)f;
 }
 
-bool CPU::GetFlag(CPUFlags f)
+bool CPU::GetFlag(CPUFlags f) const
 {
-	return ((F & (u8)f) > 0)
+	// zero and carry are what jumps test, so get those without building all of F
+	if (lazyFlags.op != FlagOp::None)
+	{
+		if (f == CPUFlags::Z)
+			return (u8)lazyFlags.result == 0;
+
+		if (f == CPUFlags::C)
+			return lazyFlags.result & 0x100;
+	}
+
+	return ((ComputeFlags() & (u8)f) > 0)
 		? true
 		: false;
 }
 
-bool CPU::GetIME()
-{
-	return IME;
-}
-
-bool CPU::IsCurrentInstructionFinished()
+void CPU::SetLazyFlags(FlagOp op, u8 lhs, u8 rhs, u16 result)
 {
-	return opcodeTimingDelay < 0;
+	lazyFlags.op = op;
+	lazyFlags.lhs = lhs;
+	lazyFlags.rhs = rhs;
+	lazyFlags.result = result;
 }
 
-std::map<u16, std::string> CPU::Disassemble(u16 startAddr, int numInstr)
+u8 CPU::ComputeFlags() const
 {
-	u32 addr = startAddr;
-	u8 value = 0x00, lo = 0x00, hi = 0x00;
-	u16 lineAddr = 0;
-
-	std::map<u16, std::string> mapAsm;
+	const LazyFlags& l = lazyFlags;
+	bool z = (u8)l.result == 0;
+	bool c = l.result & 0x100;
+	bool n, h;
 
-	while (mapAsm.size() < numInstr)
+	switch (l.op)
 	{
-		lineAddr = addr;
-
-		// prefix line with instruction addr
-		std::string s = "$" + hex(addr, 4) + ": ";
-
-		// read instruction and get readable name
-		u8 opcode = Read(addr++);
-		if (opcode == 0xCB)
-		{
-			// its a 16bit opcode so read another byte
-			opcode = Read(addr++);
+		case FlagOp::Add:
+		case FlagOp::Sub:
+			// bit 4 of the operands and result disagree when something carried out of the low nibble
+			n = l.op == FlagOp::Sub;
+			h = (l.lhs ^ l.rhs ^ l.result) & 0x10;
+			break;
+		case FlagOp::And:
+			n = false;
+			h = true;
+			break;
+		case FlagOp::Or:
+			n = false;
+			h = false;
+			break;
+		case FlagOp::Inc:
+			n = false;
+			h = (l.result & 0xF) == 0;
+			break;
+		case FlagOp::Dec:
+			n = true;
+			h = (l.result & 0xF) == 0xF;
+			break;
+		default:
+			return F;
+	}
 
-			s += instructions16bit[opcode].mnemonic;
-		}
-		else
-		{
-			auto& instruction = instructions8bit[opcode];
-			switch (instruction.bytes)
-			{
-				case 0:
-				case 1:
-				{
-					s += instructions8bit[opcode].mnemonic;
-					break;
-				}
-				case 2:
-				{
-					u8 data = Read(addr++);
-					std::string firstTwoChar(instruction.mnemonic.begin(), instruction.mnemonic.begin() + 2);
-					if (firstTwoChar == "JR")
-					{
-						s16 sdata = (s8)data;
-						sdata += addr;
-						s += std::vformat(instruction.mnemonic, std::make_format_args(hex(sdata, 4)));
-						break;
-					}
-					s += std::vformat(instruction.mnemonic, std::make_format_args(hex(data, 2)));
-					break;
-				}
-				case 3:
-				{
-					u16 lo = Read(addr++);
-					u16 hi = Read(addr++);
-					u16 data = (hi << 8) | lo;
-					s += std::vformat(instruction.mnemonic, std::make_format_args(hex(data, 4)));
-					break;
-				}
-				default:
-					throw("opcode has more than 3 bytes");
-			}
-		}
+	return (F & 0x0F) |
+		(z ? (u8)CPUFlags::Z : 0) |
+		(n ? (u8)CPUFlags::N : 0) |
+		(h ? (u8)CPUFlags::H : 0) |
+		(c ? (u8)CPUFlags::C : 0);
+}
 
-		mapAsm[lineAddr] = s;
+void CPU::MaterializeFlags()
+{
+	if (lazyFlags.op != FlagOp::None)
+	{
+		F = ComputeFlags();
+		lazyFlags.op = FlagOp::None;
 	}
+}
+
+bool CPU::GetIME()
+{
+	return IME;
+}
 
-	return mapAsm;
+bool CPU::IsCurrentInstructionFinished()
+{
+	return microOp < 0;
 }
 
 void CPU::Push(const std::same_as<u16> auto data)
@@ -1785,11 +2308,13 @@ u8 CPU::POP_AF()
 {
 	Pop(AF);
 	F &= ~(0b00001111);
+	lazyFlags.op = FlagOp::None;
 	return 0;
 }
 
 u8 CPU::PUSH_AF()
 {
+	MaterializeFlags();
 	Push(AF);
 	return 0;
 }
@@ -1823,319 +2348,151 @@ u8 CPU::LD_SP_HL()
 #pragma region 8bit Arithmetic Instructions
 u8 CPU::INC_B()
 {
-	int prev = B;
-	B++;
-
-	SetFlag(CPUFlags::Z, B == 0);
-	SetFlag(CPUFlags::N, 0);
-	SetFlag(CPUFlags::H, (B & 0xF) < (prev & 0xF));
-	
+	INC(B);
 	return 0;
 }
 
 u8 CPU::DEC_B()
 {
-	B--;
-
-	SetFlag(CPUFlags::Z, B == 0);
-	SetFlag(CPUFlags::N, 1);
-	SetFlag(CPUFlags::H, (B & 0xF) == 0xF);
-
+	DEC(B);
 	return 0;
 }
 
 u8 CPU::INC_C()
 {
-	int prev = C;
-	C++;
-
-	SetFlag(CPUFlags::Z, C == 0);
-	SetFlag(CPUFlags::N, 0);
-	SetFlag(CPUFlags::H, (C & 0xF) < (prev & 0xF));
-
+	INC(C);
 	return 0;
 }
 
 u8 CPU::DEC_C()
 {
-	C--;
-
-	SetFlag(CPUFlags::Z, C == 0);
-	SetFlag(CPUFlags::N, 1);
-	SetFlag(CPUFlags::H, (C & 0xF) == 0xF);
-
+	DEC(C);
 	return 0;
 }
 
 u8 CPU::INC_D()
 {
-	int prev = D;
-	D++;
-
-	SetFlag(CPUFlags::Z, D == 0);
-	SetFlag(CPUFlags::N, 0);
-	SetFlag(CPUFlags::H, (D & 0xF) < (prev & 0xF));
-
+	INC(D);
 	return 0;
 }
 
 u8 CPU::DEC_D()
 {
-	D--;
-
-	SetFlag(CPUFlags::Z, D == 0);
-	SetFlag(CPUFlags::N, 1);
-	SetFlag(CPUFlags::H, (D & 0xF) == 0xF);
-
+	DEC(D);
 	return 0;
 }
 
 u8 CPU::INC_E()
 {
-	int prev = E;
-	E++;
-
-	SetFlag(CPUFlags::Z, E == 0);
-	SetFlag(CPUFlags::N, 0);
-	SetFlag(CPUFlags::H, (E & 0xF) < (prev & 0xF));
-
+	INC(E);
 	return 0;
 }
 
 u8 CPU::DEC_E()
 {
-	E--;
-
-	SetFlag(CPUFlags::Z, E == 0);
-	SetFlag(CPUFlags::N, 1);
-	SetFlag(CPUFlags::H, (E & 0xF) == 0xF);
-
+	DEC(E);
 	return 0;
 }
 
 u8 CPU::INC_H()
 {
-	int prev = H;
-	H++;
-
-	SetFlag(CPUFlags::Z, H == 0);
-	SetFlag(CPUFlags::N, 0);
-	SetFlag(CPUFlags::H, (H & 0xF) < (prev & 0xF));
-
+	INC(H);
 	return 0;
 }
 
 u8 CPU::DEC_H()
 {
-	H--;
-
-	SetFlag(CPUFlags::Z, H == 0);
-	SetFlag(CPUFlags::N, 1);
-	SetFlag(CPUFlags::H, (H & 0xF) == 0xF);
-
+	DEC(H);
 	return 0;
 }
 
 u8 CPU::INC_L()
 {
-	int prev = L;
-	L++;
-
-	SetFlag(CPUFlags::Z, L == 0);
-	SetFlag(CPUFlags::N, 0);
-	SetFlag(CPUFlags::H, (L & 0xF) < (prev & 0xF));
-
+	INC(L);
 	return 0;
 }
 
 u8 CPU::DEC_L()
 {
-	L--;
-
-	SetFlag(CPUFlags::Z, L == 0);
-	SetFlag(CPUFlags::N, 1);
-	SetFlag(CPUFlags::H, (L & 0xF) == 0xF);
-
+	DEC(L);
 	return 0;
 }
 
 u8 CPU::INC_aHL()
 {
-	static int prev = 0;
-	if (opcodeTimingDelay == 1)
-	{
-		prev = Read(HL);
-		return 0;
-	}
-	
-	Write(HL, prev + 1);
+	Write(HL, hlData + 1);
 
 	SetFlag(CPUFlags::Z, Read(HL) == 0);
 	SetFlag(CPUFlags::N, 0);
-	SetFlag(CPUFlags::H, (Read(HL) & 0xF) < (prev & 0xF));
+	SetFlag(CPUFlags::H, (Read(HL) & 0xF) < (hlData & 0xF));
 
 	return 0;
 }
 
 u8 CPU::DEC_aHL()
 {
-	static int data = 0;
-	if (opcodeTimingDelay == 1)
-	{
-		data = Read(HL);
-		return 0;
-	}
-
-	Write(HL, --data);
-
-	SetFlag(CPUFlags::Z, data == 0);
-	SetFlag(CPUFlags::N, 1);
-	SetFlag(CPUFlags::H, (data & 0xF) == 0xF);
-
+	DEC(hlData);
+	Write(HL, hlData);
 	return 0;
 }
 
 u8 CPU::INC_A()
 {
-	int prev = A;
-	A++;
-
-	SetFlag(CPUFlags::Z, A == 0);
-	SetFlag(CPUFlags::N, 0);
-	SetFlag(CPUFlags::H, (A & 0xF) < (prev & 0xF));
-
+	INC(A);
 	return 0;
 }
 
 u8 CPU::DEC_A()
 {
-	A--;
-
-	SetFlag(CPUFlags::Z, A == 0);
-	SetFlag(CPUFlags::N, 1);
-	SetFlag(CPUFlags::H, (A & 0xF) == 0xF);
-
+	DEC(A);
 	return 0;
 }
 
 u8 CPU::ADD_A_B()
 {
-	int sum = A + B;
-	int noCarrySum = A ^ B;
-	int carryBits = sum ^ noCarrySum; // this sets all bits that carried
-
-	SetFlag(CPUFlags::N, 0);
-	SetFlag(CPUFlags::H, carryBits & 0x10);
-	SetFlag(CPUFlags::C, carryBits & 0x100);
-
-	A += B;
-	SetFlag(CPUFlags::Z, A == 0);
+	ADD(B);
 	return 0;
 }
 
 u8 CPU::ADD_A_C()
 {
-	int sum = A + C;
-	int noCarrySum = A ^ C;
-	int carryBits = sum ^ noCarrySum; // this sets all bits that carried
-
-	SetFlag(CPUFlags::N, 0);
-	SetFlag(CPUFlags::H, carryBits & 0x10);
-	SetFlag(CPUFlags::C, carryBits & 0x100);
-
-	A += C;
-	SetFlag(CPUFlags::Z, A == 0);
+	ADD(C);
 	return 0;
 }
 
 u8 CPU::ADD_A_D()
 {
-	int sum = A + D;
-	int noCarrySum = A ^ D;
-	int carryBits = sum ^ noCarrySum; // this sets all bits that carried
-
-	SetFlag(CPUFlags::N, 0);
-	SetFlag(CPUFlags::H, carryBits & 0x10);
-	SetFlag(CPUFlags::C, carryBits & 0x100);
-
-	A += D;
-	SetFlag(CPUFlags::Z, A == 0);
+	ADD(D);
 	return 0;
 }
 
 u8 CPU::ADD_A_E()
 {
-	int sum = A + E;
-	int noCarrySum = A ^ E;
-	int carryBits = sum ^ noCarrySum; // this sets all bits that carried
-
-	SetFlag(CPUFlags::N, 0);
-	SetFlag(CPUFlags::H, carryBits & 0x10);
-	SetFlag(CPUFlags::C, carryBits & 0x100);
-
-	A += E;
-	SetFlag(CPUFlags::Z, A == 0);
+	ADD(E);
 	return 0;
 }
 
 u8 CPU::ADD_A_H()
 {
-	int sum = A + H;
-	int noCarrySum = A ^ H;
-	int carryBits = sum ^ noCarrySum; // this sets all bits that carried
-
-	SetFlag(CPUFlags::N, 0);
-	SetFlag(CPUFlags::H, carryBits & 0x10);
-	SetFlag(CPUFlags::C, carryBits & 0x100);
-
-	A += H;
-	SetFlag(CPUFlags::Z, A == 0);
+	ADD(H);
 	return 0;
 }
 
 u8 CPU::ADD_A_L()
 {
-	int sum = A + L;
-	int noCarrySum = A ^ L;
-	int carryBits = sum ^ noCarrySum; // this sets all bits that carried
-
-	SetFlag(CPUFlags::N, 0);
-	SetFlag(CPUFlags::H, carryBits & 0x10);
-	SetFlag(CPUFlags::C, carryBits & 0x100);
-
-	A += L;
-	SetFlag(CPUFlags::Z, A == 0);
+	ADD(L);
 	return 0;
 }
 
 u8 CPU::ADD_A_aHL()
 {
-	int data = Read(HL);
-	int sum = A + data;
-	int noCarrySum = A ^ data;
-	int carryBits = sum ^ noCarrySum; // this sets all bits that carried
-
-	SetFlag(CPUFlags::N, 0);
-	SetFlag(CPUFlags::H, carryBits & 0x10);
-	SetFlag(CPUFlags::C, carryBits & 0x100);
-
-	A += data;
-	SetFlag(CPUFlags::Z, A == 0);
+	ADD(Read(HL));
 	return 0;
 }
 
 u8 CPU::ADD_A_A()
 {
-	int sum = A + A;
-	int noCarrySum = A ^ A;
-	int carryBits = sum ^ noCarrySum; // this sets all bits that carried
-
-	SetFlag(CPUFlags::N, 0);
-	SetFlag(CPUFlags::H, carryBits & 0x10);
-	SetFlag(CPUFlags::C, carryBits & 0x100);
-
-	A += A;
-	SetFlag(CPUFlags::Z, A == 0);
+	ADD(A);
 	return 0;
 }
 
@@ -2189,91 +2546,49 @@ u8 CPU::ADC_A_A()
 
 u8 CPU::SUB_A_B()
 {
-	SetFlag(CPUFlags::N, 1);
-	SetFlag(CPUFlags::H, (A & 0xF) < (B & 0xF));
-	SetFlag(CPUFlags::C, A < B);
-
-	A -= B;
-	SetFlag(CPUFlags::Z, A == 0);
+	SUB(B);
 	return 0;
 }
 
 u8 CPU::SUB_A_C()
 {
-	SetFlag(CPUFlags::N, 1);
-	SetFlag(CPUFlags::H, (A & 0xF) < (C & 0xF));
-	SetFlag(CPUFlags::C, A < C);
-
-	A -= C;
-	SetFlag(CPUFlags::Z, A == 0);
+	SUB(C);
 	return 0;
 }
 
 u8 CPU::SUB_A_D()
 {
-	SetFlag(CPUFlags::N, 1);
-	SetFlag(CPUFlags::H, (A & 0xF) < (D & 0xF));
-	SetFlag(CPUFlags::C, A < D);
-
-	A -= D;
-	SetFlag(CPUFlags::Z, A == 0);
+	SUB(D);
 	return 0;
 }
 
 u8 CPU::SUB_A_E()
 {
-	SetFlag(CPUFlags::N, 1);
-	SetFlag(CPUFlags::H, (A & 0xF) < (E & 0xF));
-	SetFlag(CPUFlags::C, A < E);
-
-	A -= E;
-	SetFlag(CPUFlags::Z, A == 0);
+	SUB(E);
 	return 0;
 }
 
 u8 CPU::SUB_A_H()
 {
-	SetFlag(CPUFlags::N, 1);
-	SetFlag(CPUFlags::H, (A & 0xF) < (H & 0xF));
-	SetFlag(CPUFlags::C, A < H);
-
-	A -= H;
-	SetFlag(CPUFlags::Z, A == 0);
+	SUB(H);
 	return 0;
 }
 
 u8 CPU::SUB_A_L()
 {
-	SetFlag(CPUFlags::N, 1);
-	SetFlag(CPUFlags::H, (A & 0xF) < (L & 0xF));
-	SetFlag(CPUFlags::C, A < L);
-
-	A -= L;
-	SetFlag(CPUFlags::Z, A == 0);
+	SUB(L);
 	return 0;
 }
 
 u8 CPU::SUB_A_aHL()
 {
-	u8 data = Read(HL);
-
-	SetFlag(CPUFlags::N, 1);
-	SetFlag(CPUFlags::H, (A & 0xF) < (data & 0xF));
-	SetFlag(CPUFlags::C, A < data);
-
-	A -= data;
-	SetFlag(CPUFlags::Z, A == 0);
+	SUB(Read(HL));
 	return 0;
 }
 
 u8 CPU::SUB_A_A()
 {
-	SetFlag(CPUFlags::N, 1);
-	SetFlag(CPUFlags::H, (A & 0xF) < (A & 0xF));
-	SetFlag(CPUFlags::C, A < A);
-
-	A -= A;
-	SetFlag(CPUFlags::Z, A == 0);
+	SUB(A);
 	return 0;
 }
 
@@ -2327,403 +2642,199 @@ u8 CPU::SBC_A_A()
 
 u8 CPU::AND_A_B()
 {
-	A &= B;
-
-	SetFlag(CPUFlags::Z, A == 0);
-	SetFlag(CPUFlags::N, 0);
-	SetFlag(CPUFlags::H, 1);
-	SetFlag(CPUFlags::C, 0);
-
+	AND(B);
 	return 0;
 }
 
 u8 CPU::AND_A_C()
 {
-	A &= C;
-
-	SetFlag(CPUFlags::Z, A == 0);
-	SetFlag(CPUFlags::N, 0);
-	SetFlag(CPUFlags::H, 1);
-	SetFlag(CPUFlags::C, 0);
-
+	AND(C);
 	return 0;
 }
 
 u8 CPU::AND_A_D()
 {
-	A &= D;
-
-	SetFlag(CPUFlags::Z, A == 0);
-	SetFlag(CPUFlags::N, 0);
-	SetFlag(CPUFlags::H, 1);
-	SetFlag(CPUFlags::C, 0);
-
+	AND(D);
 	return 0;
 }
 
 u8 CPU::AND_A_E()
 {
-	A &= E;
-
-	SetFlag(CPUFlags::Z, A == 0);
-	SetFlag(CPUFlags::N, 0);
-	SetFlag(CPUFlags::H, 1);
-	SetFlag(CPUFlags::C, 0);
-
-	return 0;
-}
-
-u8 CPU::AND_A_H()
-{
-	A &= H;
-
-	SetFlag(CPUFlags::Z, A == 0);
-	SetFlag(CPUFlags::N, 0);
-	SetFlag(CPUFlags::H, 1);
-	SetFlag(CPUFlags::C, 0);
+	AND(E);
+	return 0;
+}
 
+u8 CPU::AND_A_H()
+{
+	AND(H);
 	return 0;
 }
 
 u8 CPU::AND_A_L()
 {
-	A &= L;
-
-	SetFlag(CPUFlags::Z, A == 0);
-	SetFlag(CPUFlags::N, 0);
-	SetFlag(CPUFlags::H, 1);
-	SetFlag(CPUFlags::C, 0);
-
+	AND(L);
 	return 0;
 }
 
 u8 CPU::AND_A_aHL()
 {
-	A &= Read(HL);
-
-	SetFlag(CPUFlags::Z, A == 0);
-	SetFlag(CPUFlags::N, 0);
-	SetFlag(CPUFlags::H, 1);
-	SetFlag(CPUFlags::C, 0);
-
+	AND(Read(HL));
 	return 0;
 }
 
 u8 CPU::AND_A_A()
 {
-	A &= A;
-
-	SetFlag(CPUFlags::Z, A == 0);
-	SetFlag(CPUFlags::N, 0);
-	SetFlag(CPUFlags::H, 1);
-	SetFlag(CPUFlags::C, 0);
-
+	AND(A);
 	return 0;
 }
 
 u8 CPU::XOR_A_B()
 {
-	A ^= B;
-
-	SetFlag(CPUFlags::Z, A == 0);
-	SetFlag(CPUFlags::N, 0);
-	SetFlag(CPUFlags::H, 0);
-	SetFlag(CPUFlags::C, 0);
-
+	XOR(B);
 	return 0;
 }
 
 u8 CPU::XOR_A_C()
 {
-	A ^= C;
-
-	SetFlag(CPUFlags::Z, A == 0);
-	SetFlag(CPUFlags::N, 0);
-	SetFlag(CPUFlags::H, 0);
-	SetFlag(CPUFlags::C, 0);
-
+	XOR(C);
 	return 0;
 }
 
 u8 CPU::XOR_A_D()
 {
-	A ^= D;
-
-	SetFlag(CPUFlags::Z, A == 0);
-	SetFlag(CPUFlags::N, 0);
-	SetFlag(CPUFlags::H, 0);
-	SetFlag(CPUFlags::C, 0);
-
+	XOR(D);
 	return 0;
 }
 
 u8 CPU::XOR_A_E()
 {
-	A ^= E;
-
-	SetFlag(CPUFlags::Z, A == 0);
-	SetFlag(CPUFlags::N, 0);
-	SetFlag(CPUFlags::H, 0);
-	SetFlag(CPUFlags::C, 0);
-
+	XOR(E);
 	return 0;
 }
 
 u8 CPU::XOR_A_H()
 {
-	A ^= H;
-
-	SetFlag(CPUFlags::Z, A == 0);
-	SetFlag(CPUFlags::N, 0);
-	SetFlag(CPUFlags::H, 0);
-	SetFlag(CPUFlags::C, 0);
-
+	XOR(H);
 	return 0;
 }
 
 u8 CPU::XOR_A_L()
 {
-	A ^= L;
-
-	SetFlag(CPUFlags::Z, A == 0);
-	SetFlag(CPUFlags::N, 0);
-	SetFlag(CPUFlags::H, 0);
-	SetFlag(CPUFlags::C, 0);
-
+	XOR(L);
 	return 0;
 }
 
 u8 CPU::XOR_A_aHL()
 {
-	A ^= Read(HL);
-
-	SetFlag(CPUFlags::Z, A == 0);
-	SetFlag(CPUFlags::N, 0);
-	SetFlag(CPUFlags::H, 0);
-	SetFlag(CPUFlags::C, 0);
-
+	XOR(Read(HL));
 	return 0;
 }
 
 u8 CPU::XOR_A_A()
 {
-	A ^= A;
-
-	SetFlag(CPUFlags::Z, A == 0);
-	SetFlag(CPUFlags::N, 0);
-	SetFlag(CPUFlags::H, 0);
-	SetFlag(CPUFlags::C, 0);
-
+	XOR(A);
 	return 0;
 }
 
 u8 CPU::OR_A_B()
 {
-	A |= B;
-
-	SetFlag(CPUFlags::Z, A == 0);
-	SetFlag(CPUFlags::N, 0);
-	SetFlag(CPUFlags::H, 0);
-	SetFlag(CPUFlags::C, 0);
-
+	OR(B);
 	return 0;
 }
 
 u8 CPU::OR_A_C()
 {
-	A |= C;
-
-	SetFlag(CPUFlags::Z, A == 0);
-	SetFlag(CPUFlags::N, 0);
-	SetFlag(CPUFlags::H, 0);
-	SetFlag(CPUFlags::C, 0);
-
+	OR(C);
 	return 0;
 }
 
 u8 CPU::OR_A_D()
 {
-	A |= D;
-
-	SetFlag(CPUFlags::Z, A == 0);
-	SetFlag(CPUFlags::N, 0);
-	SetFlag(CPUFlags::H, 0);
-	SetFlag(CPUFlags::C, 0);
-
+	OR(D);
 	return 0;
 }
 
 u8 CPU::OR_A_E()
 {
-	A |= E;
-
-	SetFlag(CPUFlags::Z, A == 0);
-	SetFlag(CPUFlags::N, 0);
-	SetFlag(CPUFlags::H, 0);
-	SetFlag(CPUFlags::C, 0);
-
+	OR(E);
 	return 0;
 }
 
 u8 CPU::OR_A_H()
 {
-	A |= H;
-
-	SetFlag(CPUFlags::Z, A == 0);
-	SetFlag(CPUFlags::N, 0);
-	SetFlag(CPUFlags::H, 0);
-	SetFlag(CPUFlags::C, 0);
-
+	OR(H);
 	return 0;
 }
 
 u8 CPU::OR_A_L()
 {
-	A |= L;
-
-	SetFlag(CPUFlags::Z, A == 0);
-	SetFlag(CPUFlags::N, 0);
-	SetFlag(CPUFlags::H, 0);
-	SetFlag(CPUFlags::C, 0);
-
+	OR(L);
 	return 0;
 }
 
 u8 CPU::OR_A_aHL()
 {
-	A |= Read(HL);
-
-	SetFlag(CPUFlags::Z, A == 0);
-	SetFlag(CPUFlags::N, 0);
-	SetFlag(CPUFlags::H, 0);
-	SetFlag(CPUFlags::C, 0);
-
+	OR(Read(HL));
 	return 0;
 }
 
 u8 CPU::OR_A_A()
 {
-	A |= A;
-
-	SetFlag(CPUFlags::Z, A == 0);
-	SetFlag(CPUFlags::N, 0);
-	SetFlag(CPUFlags::H, 0);
-	SetFlag(CPUFlags::C, 0);
-
+	OR(A);
 	return 0;
 }
 
 u8 CPU::CP_A_B()
 {
-	u16 result = A - B;
-
-	SetFlag(CPUFlags::Z, result == 0);
-	SetFlag(CPUFlags::N, 1);
-	SetFlag(CPUFlags::H, (A & 0xF) < (B & 0xF));
-	SetFlag(CPUFlags::C, A < B);
-
+	CP(B);
 	return 0;
 }
 
 u8 CPU::CP_A_C()
 {
-	u16 result = A - C;
-
-	SetFlag(CPUFlags::Z, result == 0);
-	SetFlag(CPUFlags::N, 1);
-	SetFlag(CPUFlags::H, (A & 0xF) < (C & 0xF));
-	SetFlag(CPUFlags::C, A < C);
-
+	CP(C);
 	return 0;
 }
 
 u8 CPU::CP_A_D()
 {
-	u16 result = A - D;
-
-	SetFlag(CPUFlags::Z, result == 0);
-	SetFlag(CPUFlags::N, 1);
-	SetFlag(CPUFlags::H, (A & 0xF) < (D & 0xF));
-	SetFlag(CPUFlags::C, A < D);
-
+	CP(D);
 	return 0;
 }
 
 u8 CPU::CP_A_E()
 {
-	u16 result = A - E;
-
-	SetFlag(CPUFlags::Z, result == 0);
-	SetFlag(CPUFlags::N, 1);
-	SetFlag(CPUFlags::H, (A & 0xF) < (E & 0xF));
-	SetFlag(CPUFlags::C, A < E);
-
+	CP(E);
 	return 0;
 }
 
 u8 CPU::CP_A_H()
 {
-	u16 result = A - H;
-
-	SetFlag(CPUFlags::Z, result == 0);
-	SetFlag(CPUFlags::N, 1);
-	SetFlag(CPUFlags::H, (A & 0xF) < (H & 0xF));
-	SetFlag(CPUFlags::C, A < H);
-
+	CP(H);
 	return 0;
 }
 
 u8 CPU::CP_A_L()
 {
-	u16 result = A - L;
-
-	SetFlag(CPUFlags::Z, result == 0);
-	SetFlag(CPUFlags::N, 1);
-	SetFlag(CPUFlags::H, (A & 0xF) < (L & 0xF));
-	SetFlag(CPUFlags::C, A < L);
-
+	CP(L);
 	return 0;
 }
 
 u8 CPU::CP_A_aHL()
 {
-	u8 data = Read(HL);
-	u16 result = A - data;
-
-	SetFlag(CPUFlags::Z, result == 0);
-	SetFlag(CPUFlags::N, 1);
-	SetFlag(CPUFlags::H, (A & 0xF) < (data & 0xF));
-	SetFlag(CPUFlags::C, A < data);
-
+	CP(Read(HL));
 	return 0;
 }
 
 u8 CPU::CP_A_A()
 {
-	s16 result = A - A;
-
-	SetFlag(CPUFlags::Z, result == 0);
-	SetFlag(CPUFlags::N, 1);
-	SetFlag(CPUFlags::H, (A & 0xF) < (A & 0xF));
-	SetFlag(CPUFlags::C, A < A);
-
+	CP(A);
 	return 0;
 }
 
 u8 CPU::ADD_A_d8()
 {
-	u8 data = Read(PC++);
-
-	int sum = A + data;
-	int noCarrySum = A ^ data;
-	int carryBits = sum ^ noCarrySum; // this sets all bits that carried
-
-	SetFlag(CPUFlags::N, 0);
-	SetFlag(CPUFlags::H, carryBits & 0x10);
-	SetFlag(CPUFlags::C, carryBits & 0x100);
-
-	A += data;
-	SetFlag(CPUFlags::Z, A == 0);
+	ADD(Read(PC++));
 	return 0;
 }
 
@@ -2735,14 +2846,7 @@ u8 CPU::ADC_A_d8()
 
 u8 CPU::SUB_A_d8()
 {
-	u8 data = Read(PC++);
-
-	SetFlag(CPUFlags::N, 1);
-	SetFlag(CPUFlags::C, A < data);
-	SetFlag(CPUFlags::H, (A & 0xF) < (data & 0xF));
-
-	A -= data;
-	SetFlag(CPUFlags::Z, A == 0);
+	SUB(Read(PC++));
 	return 0;
 }
 
@@ -2754,50 +2858,25 @@ u8 CPU::SBC_A_d8()
 
 u8 CPU::AND_A_d8()
 {
-	A &= Read(PC++);
-
-	SetFlag(CPUFlags::Z, A == 0);
-	SetFlag(CPUFlags::N, 0);
-	SetFlag(CPUFlags::H, 1);
-	SetFlag(CPUFlags::C, 0);
-
+	AND(Read(PC++));
 	return 0;
 }
 
 u8 CPU::XOR_A_d8()
 {
-	A ^= Read(PC++);
-
-	SetFlag(CPUFlags::Z, A == 0);
-	SetFlag(CPUFlags::N, 0);
-	SetFlag(CPUFlags::H, 0);
-	SetFlag(CPUFlags::C, 0);
-
+	XOR(Read(PC++));
 	return 0;
 }
 
 u8 CPU::OR_A_d8()
 {
-	A |= Read(PC++);
-
-	SetFlag(CPUFlags::Z, A == 0);
-	SetFlag(CPUFlags::N, 0);
-	SetFlag(CPUFlags::H, 0);
-	SetFlag(CPUFlags::C, 0);
-
+	OR(Read(PC++));
 	return 0;
 }
 
 u8 CPU::CP_A_d8()
 {
-	u8 data = Read(PC++);
-	u16 result = A - data;
-
-	SetFlag(CPUFlags::Z, result == 0);
-	SetFlag(CPUFlags::N, 1);
-	SetFlag(CPUFlags::H, (A & 0xF) < (data & 0xF));
-	SetFlag(CPUFlags::C, A < data);
-
+	CP(Read(PC++));
 	return 0;
 }
 #pragma endregion
@@ -3065,16 +3144,9 @@ u8 CPU::RLC_L()
 
 u8 CPU::RLC_aHL()
 {
-	static u8 data = 0;
-	if (opcodeTimingDelay == 1)
-	{
-		data = Read(HL);
-		return 0;
-	}
+	bool bit7 = hlData & 0b10000000;
 
-	bool bit7 = data & 0b10000000;
-
-	Write(HL, (data << 1) | (u8)bit7);
+	Write(HL, (hlData << 1) | (u8)bit7);
 
 	SetFlag(CPUFlags::Z, Read(HL) == 0);
 	SetFlag(CPUFlags::N, 0);
@@ -3184,16 +3256,9 @@ u8 CPU::RRC_L()
 
 u8 CPU::RRC_aHL()
 {
-	static u8 data = 0;
-	if (opcodeTimingDelay == 1)
-	{
-		data = Read(HL);
-		return 0;
-	}
+	u8 bit0 = hlData & 0b00000001;
 
-	u8 bit0 = data & 0b00000001;
-
-	Write(HL, (data >> 1) | (bit0 << 7));
+	Write(HL, (hlData >> 1) | (bit0 << 7));
 
 	SetFlag(CPUFlags::Z, Read(HL) == 0);
 	SetFlag(CPUFlags::N, 0);
@@ -3303,16 +3368,9 @@ u8 CPU::RL_L()
 
 u8 CPU::RL_aHL()
 {
-	static u8 data = Read(HL);
-	if (opcodeTimingDelay == 1)
-	{
-		data = Read(HL);
-		return 0;
-	}
+	bool bit7 = hlData & 0b10000000;
 
-	bool bit7 = data & 0b10000000;
-
-	Write(HL, (data << 1) | (u8)GetFlag(CPUFlags::C));
+	Write(HL, (hlData << 1) | (u8)GetFlag(CPUFlags::C));
 
 	SetFlag(CPUFlags::Z, Read(HL) == 0);
 	SetFlag(CPUFlags::N, 0);
@@ -3422,15 +3480,9 @@ u8 CPU::RR_L()
 
 u8 CPU::RR_aHL()
 {
-	static u8 data = Read(HL);
-	if (opcodeTimingDelay == 1)
-	{
-		data = Read(HL);
-		return 0;
-	}
-	bool bit0 = data & 0b00000001;
+	bool bit0 = hlData & 0b00000001;
 
-	Write(HL, (data >> 1) | (u8)GetFlag(CPUFlags::C) << 7);
+	Write(HL, (hlData >> 1) | (u8)GetFlag(CPUFlags::C) << 7);
 
 	SetFlag(CPUFlags::Z, Read(HL) == 0);
 	SetFlag(CPUFlags::N, 0);
@@ -3540,16 +3592,9 @@ u8 CPU::SLA_L()
 
 u8 CPU::SLA_aHL()
 {
-	static u8 data = 0;
-	if (opcodeTimingDelay == 1)
-	{
-		data = Read(HL);
-		return 0;
-	}
-
-	bool bit7 = data & 0b10000000;
+	bool bit7 = hlData & 0b10000000;
 
-	Write(HL, data << 1);
+	Write(HL, hlData << 1);
 
 	SetFlag(CPUFlags::Z, Read(HL) == 0);
 	SetFlag(CPUFlags::N, 0);
@@ -3665,16 +3710,10 @@ u8 CPU::SRA_L()
 
 u8 CPU::SRA_aHL()
 {
-	static u8 data = 0;
-	if (opcodeTimingDelay == 1)
-	{
-		data = Read(HL);
-		return 0;
-	}
-	bool bit0 = data & 0b00000001;
-	bool bit7 = (data & 0b10000000) >> 7;
+	bool bit0 = hlData & 0b00000001;
+	bool bit7 = (hlData & 0b10000000) >> 7;
 
-	Write(HL, (data >> 1) | (bit7 << 7));
+	Write(HL, (hlData >> 1) | (bit7 << 7));
 
 	SetFlag(CPUFlags::Z, Read(HL) == 0);
 	SetFlag(CPUFlags::N, 0);
@@ -3791,15 +3830,8 @@ u8 CPU::SWAP_L()
 
 u8 CPU::SWAP_aHL()
 {
-	static u8 data = 0;
-	if (opcodeTimingDelay == 1)
-	{
-		data = Read(HL);
-		return 0;
-	}
-
-	u8 low = data & 0b00001111;
-	u8 high = data >> 4;
+	u8 low = hlData & 0b00001111;
+	u8 high = hlData >> 4;
 
 	Write(HL, (low << 4) | high);
 
@@ -3912,15 +3944,9 @@ u8 CPU::SRL_L()
 
 u8 CPU::SRL_aHL()
 {
-	static u8 data = 0;
-	if (opcodeTimingDelay == 1)
-	{
-		data = Read(HL);
-		return 0;
-	}
-	bool bit0 = data & 0b00000001;
+	bool bit0 = hlData & 0b00000001;
 
-	Write(HL, data >> 1);
+	Write(HL, hlData >> 1);
 
 	SetFlag(CPUFlags::Z, Read(HL) == 0);
 	SetFlag(CPUFlags::N, 0);
@@ -4438,13 +4464,7 @@ u8 CPU::RES_0_L()
 
 u8 CPU::RES_0_aHL()
 {
-	static u8 data = 0;
-	if (opcodeTimingDelay == 1)
-	{
-		data = Read(HL);
-		return 0;
-	}
-	Write(HL, data & ~(1 << 0));
+	Write(HL, hlData & ~(1 << 0));
 	return 0;
 }
 
@@ -4492,13 +4512,7 @@ u8 CPU::RES_1_L()
 
 u8 CPU::RES_1_aHL()
 {
-	static u8 data = 0;
-	if (opcodeTimingDelay == 1)
-	{
-		data = Read(HL);
-		return 0;
-	}
-	Write(HL, data & ~(1 << 1));
+	Write(HL, hlData & ~(1 << 1));
 	return 0;
 }
 
@@ -4546,13 +4560,7 @@ u8 CPU::RES_2_L()
 
 u8 CPU::RES_2_aHL()
 {
-	static u8 data = 0;
-	if (opcodeTimingDelay == 1)
-	{
-		data = Read(HL);
-		return 0;
-	}
-	Write(HL, data & ~(1 << 2));
+	Write(HL, hlData & ~(1 << 2));
 	return 0;
 }
 
@@ -4600,13 +4608,7 @@ u8 CPU::RES_3_L()
 
 u8 CPU::RES_3_aHL()
 {
-	static u8 data = 0;
-	if (opcodeTimingDelay == 1)
-	{
-		data = Read(HL);
-		return 0;
-	}
-	Write(HL, data & ~(1 << 3));
+	Write(HL, hlData & ~(1 << 3));
 	return 0;
 }
 
@@ -4654,13 +4656,7 @@ u8 CPU::RES_4_L()
 
 u8 CPU::RES_4_aHL()
 {
-	static u8 data = 0;
-	if (opcodeTimingDelay == 1)
-	{
-		data = Read(HL);
-		return 0;
-	}
-	Write(HL, data & ~(1 << 4));
+	Write(HL, hlData & ~(1 << 4));
 	return 0;
 }
 
@@ -4708,13 +4704,7 @@ u8 CPU::RES_5_L()
 
 u8 CPU::RES_5_aHL()
 {
-	static u8 data = 0;
-	if (opcodeTimingDelay == 1)
-	{
-		data = Read(HL);
-		return 0;
-	}
-	Write(HL, data & ~(1 << 5));
+	Write(HL, hlData & ~(1 << 5));
 	return 0;
 }
 
@@ -4762,13 +4752,7 @@ u8 CPU::RES_6_L()
 
 u8 CPU::RES_6_aHL()
 {
-	static u8 data = 0;
-	if (opcodeTimingDelay == 1)
-	{
-		data = Read(HL);
-		return 0;
-	}
-	Write(HL, data & ~(1 << 6));
+	Write(HL, hlData & ~(1 << 6));
 	return 0;
 }
 
@@ -4816,13 +4800,7 @@ u8 CPU::RES_7_L()
 
 u8 CPU::RES_7_aHL()
 {
-	static u8 data = 0;
-	if (opcodeTimingDelay == 1)
-	{
-		data = Read(HL);
-		return 0;
-	}
-	Write(HL, data & ~(1 << 7));
+	Write(HL, hlData & ~(1 << 7));
 	return 0;
 }
 
@@ -4870,13 +4848,7 @@ u8 CPU::SET_0_L()
 
 u8 CPU::SET_0_aHL()
 {
-	static u8 data = 0;
-	if (opcodeTimingDelay == 1)
-	{
-		data = Read(HL);
-		return 0;
-	}
-	Write(HL, data | (1 << 0));
+	Write(HL, hlData | (1 << 0));
 	return 0;
 }
 
@@ -4924,13 +4896,7 @@ u8 CPU::SET_1_L()
 
 u8 CPU::SET_1_aHL()
 {
-	static u8 data = 0;
-	if (opcodeTimingDelay == 1)
-	{
-		data = Read(HL);
-		return 0;
-	}
-	Write(HL, data | (1 << 1));
+	Write(HL, hlData | (1 << 1));
 	return 0;
 }
 
@@ -4978,13 +4944,7 @@ u8 CPU::SET_2_L()
 
 u8 CPU::SET_2_aHL()
 {
-	static u8 data = 0;
-	if (opcodeTimingDelay == 1)
-	{
-		data = Read(HL);
-		return 0;
-	}
-	Write(HL, data | (1 << 2));
+	Write(HL, hlData | (1 << 2));
 	return 0;
 }
 
@@ -5032,13 +4992,7 @@ u8 CPU::SET_3_L()
 
 u8 CPU::SET_3_aHL()
 {
-	static u8 data = 0;
-	if (opcodeTimingDelay == 1)
-	{
-		data = Read(HL);
-		return 0;
-	}
-	Write(HL, data | (1 << 3));
+	Write(HL, hlData | (1 << 3));
 	return 0;
 }
 
@@ -5086,13 +5040,7 @@ u8 CPU::SET_4_L()
 
 u8 CPU::SET_4_aHL()
 {
-	static u8 data = 0;
-	if (opcodeTimingDelay == 1)
-	{
-		data = Read(HL);
-		return 0;
-	}
-	Write(HL, data | (1 << 4));
+	Write(HL, hlData | (1 << 4));
 	return 0;
 }
 
@@ -5140,13 +5088,7 @@ u8 CPU::SET_5_L()
 
 u8 CPU::SET_5_aHL()
 {
-	static u8 data = 0;
-	if (opcodeTimingDelay == 1)
-	{
-		data = Read(HL);
-		return 0;
-	}
-	Write(HL, data | (1 << 5));
+	Write(HL, hlData | (1 << 5));
 	return 0;
 }
 
@@ -5194,13 +5136,7 @@ u8 CPU::SET_6_L()
 
 u8 CPU::SET_6_aHL()
 {
-	static u8 data = 0;
-	if (opcodeTimingDelay == 1)
-	{
-		data = Read(HL);
-		return 0;
-	}
-	Write(HL, data | (1 << 6));
+	Write(HL, hlData | (1 << 6));
 	return 0;
 }
 
@@ -5248,13 +5184,7 @@ u8 CPU::SET_7_L()
 
 u8 CPU::SET_7_aHL()
 {
-	static u8 data = 0;
-	if (opcodeTimingDelay == 1)
-	{
-		data = Read(HL);
-		return 0;
-	}
-	Write(HL, data | (1 << 7));
+	Write(HL, hlData | (1 << 7));
 	return 0;
 }
 
@@ -1,13 +1,12 @@
 #include "Cartridge.h"
-#include "BaseMapper.h"
-#include "MBC1.h"
-#include "MBC3.h"
+#include "SaveState.h"
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <sstream>
 
 
-std::map<MapperType, std::string> MapperTypeToString {
+const std::map<MapperType, std::string> MapperTypeToString {
 	{ MapperType::ROM_ONLY, "ROM_ONLY" },
 	{ MapperType::MBC1, "MBC1" },
 	{ MapperType::MBC1_RAM, "MBC1_RAM" },
@@ -299,13 +298,13 @@ const std::map<std::string, std::string> new_publisher_info =
 #pragma warning(push)
 #pragma warning(disable : 26495)
 Cartridge::Cartridge()
+	: mapper(std::in_place_type<RomOnly>, this)
 {
 }
 #pragma warning(pop)
 
 Cartridge::~Cartridge()
 {
-	SAFE_DELETE(mapper);
 }
 
 void Cartridge::Load(std::filesystem::path path)
@@ -337,7 +336,11 @@ void Cartridge::Load(std::filesystem::path path)
 		rom.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
 		input.close();
 
-		
+		// pad the rom out to whole banks so the mappers never have to bounds
+		// check a bank pointer
+		size_t banks = std::max<size_t>((rom.size() + 16KiB - 1) / 16KiB, 2);
+		rom.resize(banks * 16KiB, 0xFF);
+
 		// init the mapper
 		InitializeMapper();
 	}
@@ -345,27 +348,57 @@ void Cartridge::Load(std::filesystem::path path)
 
 u8 Cartridge::Read(u16 addr) const
 {
-	if (mapper != nullptr)
-	{
-		return mapper->Read(addr);
-	}
+	return std::visit([addr](const auto& m) { return m.Read(addr); }, mapper);
+}
+
+u32 Cartridge::GetRomOffset(u16 addr) const
+{
+	return GetMapper()->GetRomOffset(addr);
+}
+
+const u8* Cartridge::GetRomBank(u16 addr) const
+{
+	return GetMapper()->GetRomBank(addr);
+}
+
+u8* Cartridge::GetRamBank() const
+{
+	return GetMapper()->GetRamBank();
+}
 
-	return rom[addr];
+bool Cartridge::HasRam() const
+{
+	// not the header's ram size, mbc2 has ram the header doesn't mention
+	return !ram.empty();
 }
 
 void Cartridge::Write(u16 addr, u8 data)
 {
-	if (mapper != nullptr)
-	{
-		mapper->Write(addr, data);
-	}
+	std::visit([addr, data](auto& m) { m.Write(addr, data); }, mapper);
+}
+
+void Cartridge::SaveState(StateWriter& w) const
+{
+	std::visit([&](const auto& m) { m.SaveState(w); }, mapper);
+	w.Write(ram.data(), ram.size());
+}
+
+void Cartridge::LoadState(StateReader& r)
+{
+	std::visit([&](auto& m) { m.LoadState(r); }, mapper);
+	r.Read(ram.data(), ram.size());
+}
+
+std::span<const u8> Cartridge::GetRamData() const
+{
+	return ram;
 }
 
 void Cartridge::Reset()
 {
-	mapper = nullptr;
 	rom.clear();
 	ram.clear();
+	mapper.emplace<RomOnly>(this);
 	mapperSupported = false;
 	isLoaded = false;
 }
@@ -522,10 +555,8 @@ u16 Cartridge::GetGlobalChecksum() const
 
 const BaseMapper* Cartridge::GetMapper() const
 {
-	if (!isLoaded)
-		return nullptr;
-
-	return mapper;
+	// every mapper shares the bank pointers in BaseMapper
+	return std::visit([](const auto& m) -> const BaseMapper* { return &m; }, mapper);
 }
 
 bool Cartridge::IsMapperSupported() const
@@ -574,23 +605,41 @@ void Cartridge::InitializeMapper()
 	switch (GetMapperType())
 	{
 		case MapperType::ROM_ONLY:
-			mapper = nullptr;
+		case MapperType::ROM_RAM:
+		case MapperType::ROM_RAM_BATTERY:
+			mapper.emplace<RomOnly>(this);
 			break;
 
 		case MapperType::MBC1:
 		case MapperType::MBC1_RAM:
 		case MapperType::MBC1_RAM_BATTERY:
-			mapper = new MBC1(this);
+			mapper.emplace<MBC1>(this);
+			break;
+
+		case MapperType::MBC2:
+		case MapperType::MBC2_BATERRY:
+			ram.resize(MBC2::RamSize);
+			mapper.emplace<MBC2>(this);
 			break;
 
 		case MapperType::MBC3:
 		case MapperType::MBC3_RAM:
 		case MapperType::MBC3_RAM_BATTERY:
-			mapper = new MBC3(this);
+			mapper.emplace<MBC3>(this);
+			break;
+
+		case MapperType::MBC5:
+		case MapperType::MBC5_RAM:
+		case MapperType::MBC5_RAM_BATTERY:
+		case MapperType::MBC5_RUMBLE:
+		case MapperType::MBC5_RUMBLE_RAM:
+		case MapperType::MBC5_RUMBLE_RAM_BATTERY:
+			mapper.emplace<MBC5>(this);
 			break;
 
 		default:
-			mapper = nullptr;
+			// treat it as rom only so at least the first banks read back
+			mapper.emplace<RomOnly>(this);
 			mapperSupported = false;
 			break;
 	}
@@ -1,9 +1,12 @@
 #pragma once
 #include "GamboDefine.h"
-
-class BaseMapper;
-class MBC1;
-class MBC3;
+#include "RomOnly.h"
+#include "MBC1.h"
+#include "MBC2.h"
+#include "MBC3.h"
+#include "MBC5.h"
+#include <variant>
+#include <span>
 
 
 enum class MapperType
@@ -41,7 +44,9 @@ enum class MapperType
 
 class Cartridge
 {
+	friend class BaseMapper;
 	friend class MBC1;
+	friend class MBC2;
 	friend class MBC3;
 
 public:
@@ -52,8 +57,18 @@ public:
 
 	u8			Read(u16 addr) const;
 	void		Write(u16 addr, u8 data);
+	u32			GetRomOffset(u16 addr) const;
+	const u8*	GetRomBank(u16 addr) const;
+	u8*			GetRamBank() const;
+	bool		HasRam() const;
 	void		Reset();
 
+	// mapper registers and ram. the rom isn't saved, states only load into
+	// the same cartridge they came from.
+	void		SaveState(StateWriter& w) const;
+	void		LoadState(StateReader& r);
+	std::span<const u8> GetRamData() const;
+
 	std::string GetTitle() const;
 	std::string	GetManufacturerCode() const;
 	u8			GetCGBFlag() const;
@@ -78,11 +93,13 @@ private:
 	void DeserializeHeader();
 	void InitializeMapper();
 
-	
-	BaseMapper* mapper;
 	bool mapperSupported;
 	std::vector<u8> rom;
 	std::vector<u8> ram;
+
+	// picked when the rom is loaded. the type is known at compile time inside
+	// every visit, so reads and writes never go through a vtable.
+	std::variant<RomOnly, MBC1, MBC2, MBC3, MBC5> mapper;
 	bool isLoaded;
 
 	struct
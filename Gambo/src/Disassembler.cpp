@@ -0,0 +1,119 @@
+#include "Disassembler.h"
+#include "GamboCore.h"
+#include "CPU.h"
+#include "Cartridge.h"
+#include "spdlog/fmt/fmt.h"
+
+Disassembler::Disassembler(GamboCore* c)
+	: core(c)
+{
+}
+
+Disassembler::~Disassembler()
+{
+}
+
+const DisassemblyLine& Disassembler::GetLine(u16 addr)
+{
+	u32 page = 0;
+	bool banked = GetPage(addr, page);
+
+	if (!pages[page])
+		pages[page] = std::make_unique<Page>();
+
+	auto& line = pages[page]->lines[addr & 0x3FFF];
+	if (line.length == 0 || (!banked && IsStale(line)))
+		Decode(addr, line);
+
+	return line;
+}
+
+void Disassembler::Disassemble(u16 addr, std::span<DisassemblyLine> lines)
+{
+	for (auto& line : lines)
+	{
+		line = GetLine(addr);
+		addr += line.length;
+	}
+}
+
+void Disassembler::Clear()
+{
+	for (auto& page : pages)
+		page.reset();
+}
+
+bool Disassembler::GetPage(u16 addr, u32& page) const
+{
+	// rom is keyed by bank. an instruction at the end of a region reads its
+	// operands from the next one, which may be a different bank, so those are
+	// checked like ram.
+	if (addr <= 0x7FFF && (addr & 0x3FFF) < 0x3FFE)
+	{
+		if (core->cart->IsLoaded() && !core->IsBootRomAddress(addr))
+		{
+			page = core->cart->GetRomOffset(addr) >> 14;
+			return page < UnbankedPage;
+		}
+	}
+
+	page = UnbankedPage + (addr >> 14);
+	return false;
+}
+
+bool Disassembler::IsStale(const DisassemblyLine& line) const
+{
+	for (u8 i = 0; i < line.length; i++)
+	{
+		if (core->Read(line.addr + i) != line.bytes[i])
+			return true;
+	}
+
+	return false;
+}
+
+void Disassembler::Decode(u16 addr, DisassemblyLine& line) const
+{
+	line.addr = addr;
+	line.bytes[0] = core->Read(addr);
+
+	const char* mnemonic = nullptr;
+	char operand[5] = {};
+
+	if (line.bytes[0] == 0xCB)
+	{
+		// its a 16bit opcode so read another byte
+		line.length = 2;
+		line.bytes[1] = core->Read(addr + 1);
+		mnemonic = CPU::instructions16bit[line.bytes[1]].mnemonic;
+	}
+	else
+	{
+		auto& instruction = CPU::instructions8bit[line.bytes[0]];
+		mnemonic = instruction.mnemonic;
+
+		// unused opcodes are listed as 0 bytes, show them as 1
+		line.length = std::max<u8>(instruction.bytes, 1);
+		for (u8 i = 1; i < line.length; i++)
+			line.bytes[i] = core->Read(addr + i);
+
+		if (line.length == 2)
+		{
+			// show where relative jumps land instead of the offset
+			bool isJR = line.bytes[0] == 0x18 || (line.bytes[0] & 0b11100111) == 0b00100000;
+			if (isJR)
+				fmt::format_to_n(operand, 4, "{:04X}", (u16)(addr + 2 + (s8)line.bytes[1]));
+			else
+				fmt::format_to_n(operand, 2, "{:02X}", line.bytes[1]);
+		}
+		else if (line.length == 3)
+		{
+			fmt::format_to_n(operand, 4, "{:04X}", line.bytes[2] << 8 | line.bytes[1]);
+		}
+	}
+
+	// prefix line with instruction addr
+	auto out = fmt::format_to_n(line.text.data(), line.text.size() - 1, "${:04X}: ", addr).out;
+	out = fmt::format_to_n(out, line.text.data() + line.text.size() - 1 - out, fmt::runtime(mnemonic), std::string_view(operand)).out;
+	*out = '\0';
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include "GamboDefine.h"
+#include <memory>
+#include <span>
+
+class GamboCore;
+
+// one instruction, formatted once and kept
+struct DisassemblyLine
+{
+	u16 addr = 0;
+	u8 length = 0;					// 0 until the line has been decoded
+	std::array<u8, 3> bytes{};		// what it was decoded from
+	std::array<char, 28> text{};	// "$0150: $C3 JP 0150", null terminated
+};
+
+// disassembled lines keyed by page and the address inside that 16 KiB page,
+// like the block cache. rom lines are keyed by the bank they were read from,
+// so switching banks picks other lines instead of throwing them away, and
+// they live until the next reset. anything else (ram, the boot rom) keeps
+// the bytes it was decoded from and is redone once they've been written.
+class Disassembler
+{
+public:
+	Disassembler(GamboCore* c);
+	~Disassembler();
+
+	const DisassemblyLine& GetLine(u16 addr);
+
+	// fills lines with consecutive instructions starting at addr. doesn't
+	// allocate once the pages it touches have been seen.
+	void Disassemble(u16 addr, std::span<DisassemblyLine> lines);
+
+	void Clear();
+
+	bool operator==(const Disassembler& other) const = delete;
+
+private:
+	static constexpr u32 UnbankedPage = 0x200;
+
+	// returns false for lines that have to be checked against memory
+	bool GetPage(u16 addr, u32& page) const;
+	bool IsStale(const DisassemblyLine& line) const;
+	void Decode(u16 addr, DisassemblyLine& line) const;
+
+	struct Page
+	{
+		std::array<DisassemblyLine, 16KiB> lines;
+	};
+
+	GamboCore* core;
+	std::array<std::unique_ptr<Page>, UnbankedPage + 4> pages;
+};
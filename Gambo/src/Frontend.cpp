@@ -6,14 +6,17 @@
 #include "imgui_impl_sdlrenderer2.h"
 #include <sstream>
 #include <exception>
+#include <algorithm>
 #include "PPU.h"
 #include "VramViewer.h"
+#include "Input.h"
 
 ImVec4 clear_color;
 constexpr auto MainWindowTitle = "Gambo";
 constexpr auto GamboWindowTitle = "Gambo Window";
 constexpr auto CPUInfoWindowTitle = "Debug Info";
 constexpr auto VramViewerWindowTitle = "Vram Viewer";
+constexpr auto BreakpointsWindowTitle = "Breakpoints";
 bool debugMode = false;
 
 Frontend::Frontend()
@@ -43,8 +46,8 @@ Frontend::Frontend()
 
 	SDL_WindowFlags window_flags = (SDL_WindowFlags)(SDL_WINDOW_SHOWN | SDL_WINDOW_OPENGL | SDL_WINDOW_ALLOW_HIGHDPI | SDL_WINDOW_RESIZABLE);
 	int menuBarHeight = ImGui::GetFontSize() + (style.FramePadding.y * 2);
-	int windowSizeX = (GamboScreenWidth * PixelScale) + (style.WindowPadding.x * 2);
-	int windowSizeY = (GamboScreenHeight * PixelScale) + (style.WindowPadding.y * 2) + menuBarHeight + 13; // pls dont ask where the extra 13 pixels comes from...
+	int windowSizeX = (GamboScreenWidth * pixelScale) + (style.WindowPadding.x * 2);
+	int windowSizeY = (GamboScreenHeight * pixelScale) + (style.WindowPadding.y * 2) + menuBarHeight + 13; // pls dont ask where the extra 13 pixels comes from...
 	window = SDL_CreateWindow(MainWindowTitle, SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, windowSizeX, windowSizeY, window_flags);
 	SDL_assert_release(window);
 	
@@ -85,7 +88,9 @@ Frontend::Frontend()
 	//ImFont* font = io.Fonts->AddFontFromFileTTF("c:\\Windows\\Fonts\\ArialUni.ttf", 18.0f, nullptr, io.Fonts->GetGlyphRangesJapanese());
 	//IM_ASSERT(font != nullptr);
 
-	gambo = std::make_unique<GamboCore>();
+	gambo = std::make_unique<GamboThread>();
+	gambo->Send({ GamboCommandType::SetFastForwardSpeed, fastForwardSpeed });
+	gambo->Send({ GamboCommandType::SetFrameSkip, frameSkip });
 }
 
 Frontend::~Frontend()
@@ -100,31 +105,21 @@ Frontend::~Frontend()
 
 void Frontend::Run()
 {
-	//std::thread gamboThread([&]() { gambo->Run(); });
-	
-
+	// the core runs and paces itself on its own thread. this loop only
+	// forwards input and draws whatever frame was finished last, vsync paces it.
 	while (!done)
 	{
-		using namespace std::chrono;
-		using clock = high_resolution_clock;
-		using framerate = duration<int, std::ratio<100, 5973>>;
-		auto timePoint = clock::now() + framerate{1};
+		UpdateJoypad();
+		UpdateFastForward();
+		UpdateRewind();
+
+		if (gambo->UpdateFrame())
+			SDL_UpdateTexture(gamboScreen, NULL, gambo->GetFrame().screen.data(), GamboScreenWidth * BytesPerPixel);
 
-		gambo->Run();
 		BeginFrame();
 		UpdateUI();
 		EndFrame();
-
-		// limit fps
-		std::this_thread::sleep_until(timePoint - 5ms);
-		while (clock::now() <= timePoint)
-		{
-			// wait
-		}
-		timePoint += framerate{100};
 	}
-
-	//gamboThread.join();
 }
 
 void Frontend::BeginFrame()
@@ -173,6 +168,7 @@ void Frontend::UpdateUI()
 	{
 		DrawCPUInfoWindow();
 		DrawVramViewer();
+		DrawBreakpointsWindow();
 	}
 	//ImGui::ShowDemoWindow();
 }
@@ -190,11 +186,6 @@ void Frontend::EndFrame()
 	SDL_RenderClear(renderer);
 	ImGui_ImplSDLRenderer2_RenderDrawData(ImGui::GetDrawData());
 	SDL_RenderPresent(renderer);
-
-	if (done)
-	{
-		gambo->SetDone(true);
-	}
 }
 
 void Frontend::HandleKeyboardShortcuts()
@@ -210,7 +201,16 @@ void Frontend::HandleKeyboardShortcuts()
 		SetGamboRunning();
 
 	if (ImGui::IsKeyDown(ImGuiMod_Ctrl) && ImGui::IsKeyPressed(ImGuiKey_R))
-		gambo->Reset();
+		gambo->Send({ GamboCommandType::Reset });
+
+	if (ImGui::IsKeyDown(ImGuiMod_Ctrl) && ImGui::IsKeyPressed(ImGuiKey_F))
+		fastForwardToggled = !fastForwardToggled;
+
+	if (ImGui::IsKeyPressed(ImGuiKey_F5) && !romPath.empty())
+		gambo->Send({ GamboCommandType::SaveState, 0, GetStatePath() });
+
+	if (ImGui::IsKeyPressed(ImGuiKey_F8) && !romPath.empty())
+		gambo->Send({ GamboCommandType::LoadState, 0, GetStatePath() });
 
 	if (debugMode)
 	{
@@ -222,25 +222,80 @@ void Frontend::HandleKeyboardShortcuts()
 	}
 }
 
+bool Frontend::IsFastForward() const
+{
+	// holding space fast forwards without touching the toggle
+	return fastForwardToggled || ImGui::IsKeyDown(ImGuiKey_Space);
+}
+
+void Frontend::UpdateJoypad()
+{
+	u8 buttons = 0;
+	if (ImGui::IsKeyDown(ImGuiKey_RightArrow))	buttons |= (u8)JoypadButton::Right;
+	if (ImGui::IsKeyDown(ImGuiKey_LeftArrow))	buttons |= (u8)JoypadButton::Left;
+	if (ImGui::IsKeyDown(ImGuiKey_UpArrow))		buttons |= (u8)JoypadButton::Up;
+	if (ImGui::IsKeyDown(ImGuiKey_DownArrow))	buttons |= (u8)JoypadButton::Down;
+	if (ImGui::IsKeyDown(ImGuiKey_Z))			buttons |= (u8)JoypadButton::A;
+	if (ImGui::IsKeyDown(ImGuiKey_X))			buttons |= (u8)JoypadButton::B;
+	if (ImGui::IsKeyDown(ImGuiKey_Backspace))	buttons |= (u8)JoypadButton::Select;
+	if (ImGui::IsKeyDown(ImGuiKey_Enter))		buttons |= (u8)JoypadButton::Start;
+
+	if (buttons != joypad)
+	{
+		joypad = buttons;
+		gambo->Send({ GamboCommandType::SetJoypad, joypad });
+	}
+}
+
+void Frontend::UpdateFastForward()
+{
+	bool fastForward = IsFastForward();
+	if (fastForward != fastForwardActive)
+	{
+		fastForwardActive = fastForward;
+		gambo->Send({ GamboCommandType::SetFastForward, fastForwardActive });
+	}
+}
+
+std::filesystem::path Frontend::GetStatePath() const
+{
+	// one state per game, next to the rom
+	return std::filesystem::path(romPath).replace_extension(".state");
+}
+
+void Frontend::UpdateRewind()
+{
+	// hold R, ctrl+R is reset
+	bool rewind = ImGui::IsKeyDown(ImGuiKey_R) && !ImGui::IsKeyDown(ImGuiMod_Ctrl) && rewindBudget > 0;
+	if (rewind != rewindActive)
+	{
+		rewindActive = rewind;
+		gambo->Send({ GamboCommandType::SetRewinding, rewindActive });
+	}
+}
+
 void Frontend::OpenGameFromFile(std::filesystem::path filePath)
 {
 	if (filePath.extension() == ".gb")
 	{
-		gambo->InsertCartridge(filePath);
+		gambo->Send({ GamboCommandType::InsertCartridge, 0, filePath });
+		gambo->Flush();
 
-		auto& cart = gambo->GetCartridge();
+		auto& cart = gambo->GetCore().GetCartridge();
 		if (!cart.IsMapperSupported())
 		{
 			std::stringstream ss;
 			ss << "Gambo does not yet implement mapper " << cart.GetMapperTypeAsString() << ".";
 			SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, "Mapper not supported!", ss.str().c_str(), window);
-			gambo = std::make_unique<GamboCore>();
+			gambo->Send({ GamboCommandType::EjectCartridge });
+			romPath.clear();
 		}
 		else
 		{
 			std::stringstream ss;
 			ss << MainWindowTitle << ": " << cart.GetTitle() << " - " << cart.GetPublisher();
 			SDL_SetWindowTitle(window, ss.str().c_str());
+			romPath = filePath;
 		}
 	}
 	else if (filePath != "")
@@ -293,19 +348,111 @@ void Frontend::DrawGamboWindow()
 				{
 					OpenGameFromFile();
 				}
+
+				ImGui::Separator();
+
+				if (ImGui::MenuItem("Save State", "F5", false, !romPath.empty()))
+					gambo->Send({ GamboCommandType::SaveState, 0, GetStatePath() });
+
+				if (ImGui::MenuItem("Load State", "F8", false, !romPath.empty()))
+					gambo->Send({ GamboCommandType::LoadState, 0, GetStatePath() });
+
 				ImGui::EndMenu();
 			}
 
 			if (ImGui::BeginMenu("Gambo"))
 			{
-				if (ImGui::MenuItem(!gambo->GetRunning() ? "Play" : "Pause", "Ctrl+P"))
+				if (ImGui::MenuItem(!gambo->IsRunning() ? "Play" : "Pause", "Ctrl+P"))
 				{
 					SetGamboRunning();
 				}
 
 				if (ImGui::MenuItem("Reset", "Ctrl+R"))
 				{
-					gambo->Reset();
+					gambo->Send({ GamboCommandType::Reset });
+				}
+
+				ImGui::MenuItem("Fast Forward", "Ctrl+F / Hold Space", &fastForwardToggled);
+
+				if (ImGui::BeginMenu("Fast Forward Speed"))
+				{
+					for (int speed : { 2, 4, 8, GamboThread::UnlimitedSpeed })
+					{
+						std::stringstream ss;
+						if (speed == GamboThread::UnlimitedSpeed)
+							ss << "Unlimited";
+						else
+							ss << speed << "x";
+
+						if (ImGui::MenuItem(ss.str().c_str(), nullptr, fastForwardSpeed == speed))
+						{
+							fastForwardSpeed = speed;
+							gambo->Send({ GamboCommandType::SetFastForwardSpeed, fastForwardSpeed });
+						}
+					}
+					ImGui::EndMenu();
+				}
+
+				if (ImGui::BeginMenu("Fast Forward Frame Skip"))
+				{
+					for (int skip : { 1, 2, 4, 8, 16 })
+					{
+						std::stringstream ss;
+						ss << "Present every " << skip << (skip == 1 ? " frame" : " frames");
+
+						if (ImGui::MenuItem(ss.str().c_str(), nullptr, frameSkip == skip))
+						{
+							frameSkip = skip;
+							gambo->Send({ GamboCommandType::SetFrameSkip, frameSkip });
+						}
+					}
+					ImGui::EndMenu();
+				}
+
+				if (ImGui::BeginMenu("Rewind Buffer"))
+				{
+					ImGui::TextColored(GREY, "Hold R to rewind");
+					ImGui::TextColored(GREY, "%.1f s stored in %.1f MB", gambo->GetRewindSeconds(), gambo->GetRewindMemory() / (1024.0 * 1024.0));
+					ImGui::Separator();
+
+					for (int budget : { 0, 16, 32, 64, 128 })
+					{
+						std::stringstream ss;
+						if (budget == 0)
+							ss << "Off";
+						else
+							ss << budget << " MB";
+
+						if (ImGui::MenuItem(ss.str().c_str(), nullptr, rewindBudget == budget))
+						{
+							rewindBudget = budget;
+							gambo->Send({ GamboCommandType::SetRewindBudget, rewindBudget });
+						}
+					}
+					ImGui::EndMenu();
+				}
+
+				if (ImGui::BeginMenu("Run Ahead"))
+				{
+					ImGui::TextColored(GREY, "Off while debugging tools are in use");
+					ImGui::TextColored(GREY, "%.3f ms per frame", gambo->GetRunAheadCost());
+					ImGui::Separator();
+
+					for (int frames = 0; frames <= GamboThread::MaxRunAhead; frames++)
+					{
+						std::stringstream ss;
+						if (frames == 0)
+							ss << "Off";
+						else
+							ss << frames << (frames == 1 ? " frame" : " frames");
+
+						if (ImGui::MenuItem(ss.str().c_str(), nullptr, runAhead == frames))
+						{
+							runAhead = frames;
+							gambo->Send({ GamboCommandType::SetRunAhead, runAhead });
+						}
+					}
+					ImGui::EndMenu();
 				}
 
 				if (debugMode)
@@ -329,7 +476,7 @@ void Frontend::DrawGamboWindow()
 				
 				static bool useBootRom = gambo->IsUseBootRom();
 				if (ImGui::MenuItem("Use Boot Rom", nullptr, &useBootRom))
-					gambo->SetUseBootRom(useBootRom);
+					gambo->Send({ GamboCommandType::SetUseBootRom, useBootRom });
 
 				ImGui::Separator();
 
@@ -342,7 +489,7 @@ void Frontend::DrawGamboWindow()
 				{
 					std::array<bool, PixelScaleMax> scale;
 					scale.fill(false);
-					scale[PixelScale - 1] = true;
+					scale[pixelScale - 1] = true;
 
 					std::stringstream ss;
 					for (int i = 0; i < scale.size(); i++)
@@ -352,11 +499,11 @@ void Frontend::DrawGamboWindow()
 						ss << i + 1 << "x";
 						if (ImGui::MenuItem(ss.str().c_str(), nullptr, &scale[i]))
 						{
-							PixelScale = i + 1;
-							windowSize.x = (GamboScreenWidth * PixelScale) + (style.WindowPadding.x * 2);
+							pixelScale = i + 1;
+							windowSize.x = (GamboScreenWidth * pixelScale) + (style.WindowPadding.x * 2);
 							windowSize.y = !debugMode
-								? (GamboScreenHeight * PixelScale) + (style.WindowPadding.y * 2) + menuBarHeight
-								: (GamboScreenHeight * PixelScale) + (style.WindowPadding.y * 2) + menuBarHeight + titleBarHeight + 13;
+								? (GamboScreenHeight * pixelScale) + (style.WindowPadding.y * 2) + menuBarHeight
+								: (GamboScreenHeight * pixelScale) + (style.WindowPadding.y * 2) + menuBarHeight + titleBarHeight + 13;
 							ImGui::SetWindowSize(windowSize);
 
 							if (!debugMode)
@@ -377,6 +524,9 @@ void Frontend::DrawGamboWindow()
 			}
 
 			ImGui::TextColored(WHITE, "%.3f ms (%.3f FPS)", 1000.0f / io.Framerate, io.Framerate);
+			ImGui::TextColored(IsFastForward() ? YELLOW : WHITE, "%.2fx", gambo->GetAchievedSpeed());
+			if (runAhead > 0)
+				ImGui::TextColored(GREY, "+%.3f ms run ahead", gambo->GetRunAheadCost());
 
 			ImGui::EndMenuBar();
 		}
@@ -402,14 +552,13 @@ void Frontend::DrawGamboWindow()
 		
 
 		ImGui::SetCursorPos(ImGui::GetCursorPos() + (ImGui::GetContentRegionAvail() - gamboScreenSize) * 0.5f);
-		SDL_UpdateTexture(gamboScreen, NULL, gambo->GetScreen(), GamboScreenWidth * BytesPerPixel);
 		ImGui::Image(gamboScreen, gamboScreenSize);
 
 		if (!debugMode)
 		{
-			// update PixelScale if the window was resized
-			PixelScale = std::max((int)gamboScreenSize.x / GamboScreenWidth, 1);
-			PixelScale = std::min(PixelScale, PixelScaleMax);
+			// update pixel scale if the window was resized
+			pixelScale = std::max((int)gamboScreenSize.x / GamboScreenWidth, 1);
+			pixelScale = std::min(pixelScale, PixelScaleMax);
 
 			// set the window size to match gambo screen
 			windowSize = { gamboScreenSize.x + (style.WindowPadding.x * 2), gamboScreenSize.y + (style.WindowPadding.y * 2) + menuBarHeight };
@@ -433,7 +582,7 @@ void Frontend::DrawCPUInfoWindow()
 
 	ImGui::Begin(CPUInfoWindowTitle, nullptr, ImGuiWindowFlags_NoResize);
 	{
-		auto state = gambo->GetState();
+		auto& state = gambo->GetFrame().state;
 		//ImGui::TextColored(WHITE, "%.3f ms/frame (%.1f FPS)", 1000.0f / io.Framerate, io.Framerate);
 		ImGui::TextColored(WHITE, "FLAGS: ");
 		ImGui::SameLine(); ImGui::TextColored(state.flags.Z ? GREEN : RED, "Z");
@@ -455,9 +604,9 @@ void Frontend::DrawCPUInfoWindow()
 		ImGui::SeparatorEx(ImGuiSeparatorFlags_Horizontal, 2.0f);
 
 		bool first = true;
-		for (auto& line : state.mapAsm)
+		for (auto& line : state.disassembly)
 		{
-			ImGui::TextColored(first == true ? CYAN : WHITE, line.second.c_str());
+			ImGui::TextColored(first == true ? CYAN : WHITE, "%s", line.text.data());
 			first = false;
 		}
 	}
@@ -493,7 +642,7 @@ void Frontend::DrawVramViewer()
 			ImDrawList* drawList = ImGui::GetWindowDrawList();
 			ImGuiIO& io = ImGui::GetIO();
 
-			SDL_UpdateTexture(gamboVramView, NULL, gambo->GetVramViewer().GetView().data(), vramViewWidth * BytesPerPixel);
+			SDL_UpdateTexture(gamboVramView, NULL, gambo->GetCore().GetVramViewer().GetView().data(), vramViewWidth * BytesPerPixel);
 			ImGui::Image(gamboVramView, { vramViewWidth, vramViewWidth });
 
 			if (showGrid)
@@ -515,8 +664,8 @@ void Frontend::DrawVramViewer()
 
 			if (showScreen)
 			{
-				u8 SCX = gambo->Read(HWAddr::SCX);
-				u8 SCY = gambo->Read(HWAddr::SCY);
+				u8 SCX = gambo->GetCore().Read(HWAddr::SCX);
+				u8 SCY = gambo->GetCore().Read(HWAddr::SCY);
 
 				float gridMaxX = imguiCursorPos.x + vramViewWidth;
 				float gridMaxY = imguiCursorPos.y + vramViewWidth;
@@ -583,16 +732,16 @@ void Frontend::DrawVramViewer()
 			{
 				case 0:
 				{
-					gambo->GetVramViewer().SetTileMapBaseAddr(-1);
+					gambo->GetCore().GetVramViewer().SetTileMapBaseAddr(-1);
 				}
 				case 1:
 				{
-					gambo->GetVramViewer().SetTileMapBaseAddr(0x9800);
+					gambo->GetCore().GetVramViewer().SetTileMapBaseAddr(0x9800);
 					break;
 				}
 				case 2:
 				{
-					gambo->GetVramViewer().SetTileMapBaseAddr(0x9C00);
+					gambo->GetCore().GetVramViewer().SetTileMapBaseAddr(0x9C00);
 					break;
 				}
 			}
@@ -601,17 +750,17 @@ void Frontend::DrawVramViewer()
 			{
 				case 0:
 				{
-					gambo->GetVramViewer().SetTileDataBaseAddr(-1);
+					gambo->GetCore().GetVramViewer().SetTileDataBaseAddr(-1);
 					break;
 				}
 				case 1:
 				{
-					gambo->GetVramViewer().SetTileDataBaseAddr(0x9000);
+					gambo->GetCore().GetVramViewer().SetTileDataBaseAddr(0x9000);
 					break;
 				}
 				case 2:
 				{
-					gambo->GetVramViewer().SetTileDataBaseAddr(0x8000);
+					gambo->GetCore().GetVramViewer().SetTileDataBaseAddr(0x8000);
 					break;
 				}
 			}
@@ -627,11 +776,11 @@ void Frontend::DrawVramViewer()
 			ImGui::SameLine(); ImGui::TextColored(GREEN, "Y:"); 
 			ImGui::SameLine(); ImGui::Text("$%02X", tileY);
 
-			u8 LCDC = gambo->Read(HWAddr::LCDC);
+			u8 LCDC = gambo->GetCore().Read(HWAddr::LCDC);
 
 
-			u16 tileMapBaseAddr = gambo->GetVramViewer().GetTileMapBaseAddr() != -1 ? gambo->GetVramViewer().GetTileMapBaseAddr() :GetBits(LCDC, (u8)LCDCBits::BGTileMapArea, 0x1) ? 0x9C00 : 0x9800;
-			u16 tileDataBaseAddr = gambo->GetVramViewer().GetTileDataBaseAddr() != -1 ? gambo->GetVramViewer().GetTileDataBaseAddr() : GetBits(LCDC, (u8)LCDCBits::TileDataArea, 0b1) ? 0x8000 : 0x8800;
+			u16 tileMapBaseAddr = gambo->GetCore().GetVramViewer().GetTileMapBaseAddr() != -1 ? gambo->GetCore().GetVramViewer().GetTileMapBaseAddr() :GetBits(LCDC, (u8)LCDCBits::BGTileMapArea, 0x1) ? 0x9C00 : 0x9800;
+			u16 tileDataBaseAddr = gambo->GetCore().GetVramViewer().GetTileDataBaseAddr() != -1 ? gambo->GetCore().GetVramViewer().GetTileDataBaseAddr() : GetBits(LCDC, (u8)LCDCBits::TileDataArea, 0b1) ? 0x8000 : 0x8800;
 			u16 mapAddr = tileMapBaseAddr + (32 * tileY) + tileX;
 
 			ImGui::TextColored(CYAN, "Map Addr: "); ImGui::SameLine();
@@ -641,12 +790,12 @@ void Frontend::DrawVramViewer()
 
 			if (tileDataBaseAddr == 0x8800)
 			{
-				tileIndex = static_cast<s8> (gambo->Read(mapAddr));
+				tileIndex = static_cast<s8> (gambo->GetCore().Read(mapAddr));
 				tileIndex += 128;
 			}
 			else
 			{
-				tileIndex = gambo->Read(mapAddr);
+				tileIndex = gambo->GetCore().Read(mapAddr);
 			}
 
 			ImGui::TextColored(CYAN, "Tile Addr:"); 
@@ -664,21 +813,150 @@ void Frontend::DrawVramViewer()
 	ImGui::End();
 }
 
+void Frontend::DrawBreakpointsWindow()
+{
+	static constexpr const char* registerNames[] = { "-", "A", "F", "B", "C", "D", "E", "H", "L", "AF", "BC", "DE", "HL", "SP" };
+	static constexpr const char* compareNames[] = { "==", "!=", "<", "<=", ">", ">=" };
+	static constexpr const char* interruptNames[] = { "VBlank", "LCD", "Timer", "Serial", "Joypad" };
+	constexpr auto hexInput = ImGuiInputTextFlags_CharsHexadecimal;
+
+	ImGui::Begin(BreakpointsWindowTitle, nullptr, ImGuiWindowFlags_AlwaysAutoResize);
+	{
+		auto& hit = gambo->GetFrame().state.breakHit;
+		switch (hit.reason)
+		{
+			case BreakReason::Execute:
+				ImGui::TextColored(YELLOW, "Hit: execute 0x%.4X", hit.addr);
+				break;
+			case BreakReason::Read:
+				ImGui::TextColored(YELLOW, "Hit: read 0x%.2X from 0x%.4X", hit.value, hit.addr);
+				break;
+			case BreakReason::Write:
+				ImGui::TextColored(YELLOW, "Hit: write 0x%.2X to 0x%.4X", hit.value, hit.addr);
+				break;
+			case BreakReason::Interrupt:
+				ImGui::TextColored(YELLOW, "Hit: interrupt 0x%.4X", hit.addr);
+				break;
+			default:
+				ImGui::TextColored(GREY, "Not stopped at a breakpoint");
+				break;
+		}
+
+		ImGui::SeparatorEx(ImGuiSeparatorFlags_Horizontal, 2.0f);
+
+		// the breakpoint being put together
+		ImGui::SetNextItemWidth(40);
+		ImGui::InputScalar("-", ImGuiDataType_U16, &newBreakpoint.start, nullptr, nullptr, "%04X", hexInput);
+		ImGui::SameLine();
+		ImGui::SetNextItemWidth(40);
+		ImGui::InputScalar("##End", ImGuiDataType_U16, &newBreakpoint.end, nullptr, nullptr, "%04X", hexInput);
+
+		int kinds = newBreakpoint.kinds;
+		ImGui::SameLine(); ImGui::CheckboxFlags("X", &kinds, (int)BreakKind::Execute);
+		ImGui::SameLine(); ImGui::CheckboxFlags("R", &kinds, (int)BreakKind::Read);
+		ImGui::SameLine(); ImGui::CheckboxFlags("W", &kinds, (int)BreakKind::Write);
+		newBreakpoint.kinds = (u8)kinds;
+
+		int reg = (int)newBreakpoint.condition.reg;
+		int compare = (int)newBreakpoint.condition.compare;
+		ImGui::SetNextItemWidth(50);
+		ImGui::Combo("##Register", &reg, registerNames, IM_ARRAYSIZE(registerNames));
+		ImGui::SameLine();
+		ImGui::SetNextItemWidth(50);
+		ImGui::Combo("##Compare", &compare, compareNames, IM_ARRAYSIZE(compareNames));
+		ImGui::SameLine();
+		ImGui::SetNextItemWidth(40);
+		ImGui::InputScalar("##Value", ImGuiDataType_U16, &newBreakpoint.condition.value, nullptr, nullptr, "%04X", hexInput);
+		newBreakpoint.condition.reg = (BreakRegister)reg;
+		newBreakpoint.condition.compare = (BreakCompare)compare;
+
+		if (ImGui::Button("Add") && newBreakpoint.kinds != 0)
+		{
+			Breakpoint b = newBreakpoint;
+			b.end = std::max(b.end, b.start);
+			AddBreakpoint(b);
+		}
+
+		ImGui::SameLine();
+		if (ImGui::Button("Break On IO Writes"))
+			AddBreakpoint({ 0xFF00, 0xFF7F, (u8)BreakKind::Write });
+
+		ImGui::SeparatorEx(ImGuiSeparatorFlags_Horizontal, 2.0f);
+
+		for (int i = 0; i < (int)breakpoints.size(); i++)
+		{
+			auto& b = breakpoints[i];
+			bool fired = hit.index == i;
+
+			ImGui::PushID(i);
+			if (ImGui::SmallButton("x"))
+			{
+				breakpoints.erase(breakpoints.begin() + i);
+				gambo->Send({ GamboCommandType::RemoveBreakpoint, i });
+				ImGui::PopID();
+				break;
+			}
+			ImGui::PopID();
+
+			ImGui::SameLine();
+			ImGui::TextColored(fired ? YELLOW : WHITE, "%.4X-%.4X %c%c%c", b.start, b.end,
+				(b.kinds & (u8)BreakKind::Execute) ? 'X' : '-',
+				(b.kinds & (u8)BreakKind::Read) ? 'R' : '-',
+				(b.kinds & (u8)BreakKind::Write) ? 'W' : '-');
+
+			if (b.condition.reg != BreakRegister::None)
+			{
+				ImGui::SameLine();
+				ImGui::TextColored(fired ? YELLOW : WHITE, "if %s %s 0x%.4X", registerNames[(int)b.condition.reg],
+					compareNames[(int)b.condition.compare], b.condition.value);
+			}
+		}
+
+		if (!breakpoints.empty() && ImGui::Button("Clear All"))
+		{
+			breakpoints.clear();
+			breakOnInterrupts = 0;
+			gambo->Send({ GamboCommandType::ClearBreakpoints });
+		}
+
+		ImGui::SeparatorEx(ImGuiSeparatorFlags_Horizontal, 2.0f);
+
+		// break when any of these is dispatched
+		bool changed = false;
+		for (int i = 0; i < IM_ARRAYSIZE(interruptNames); i++)
+		{
+			if (i > 0)
+				ImGui::SameLine();
+			changed |= ImGui::CheckboxFlags(interruptNames[i], &breakOnInterrupts, 1 << i);
+		}
+
+		if (changed)
+			gambo->Send({ GamboCommandType::SetBreakOnInterrupts, breakOnInterrupts });
+	}
+
+	ImGui::End();
+}
+
+void Frontend::AddBreakpoint(const Breakpoint& b)
+{
+	breakpoints.push_back(b);
+
+	GamboCommand command{ GamboCommandType::AddBreakpoint };
+	command.breakpoint = b;
+	gambo->Send(std::move(command));
+}
+
 void Frontend::SetGamboRunning()
 {
-	gambo->SetRunning(!gambo->GetRunning());
-	if (gambo->GetRunning())
-		gambo->SetStep(false);
+	gambo->Send({ gambo->IsRunning() ? GamboCommandType::Pause : GamboCommandType::Play });
 }
 
 void Frontend::SetGamboStep()
 {
-	gambo->SetRunning(false);
-	gambo->SetStep(true);
+	gambo->Send({ GamboCommandType::Step });
 }
 
 void Frontend::SetGamboStepFrame()
 {
-	gambo->SetRunning(false);
-	gambo->SetStepFrame(true);
+	gambo->Send({ GamboCommandType::StepFrame });
 }
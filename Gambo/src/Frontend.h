@@ -1,7 +1,7 @@
 #pragma once
 #include <atomic>
-#include "SDL.h"
-#include "GamboCore.h"
+#include "FrontendDefine.h"
+#include "GamboThread.h"
 #include "FileDialogs.h"
 #include <filesystem>
 
@@ -18,22 +18,46 @@ private:
 	void UpdateUI();
 	void EndFrame();
 	void HandleKeyboardShortcuts();
+	void UpdateJoypad();
+	void UpdateFastForward();
+	bool IsFastForward() const;
+	void UpdateRewind();
+	std::filesystem::path GetStatePath() const;
 	void OpenGameFromFile(std::filesystem::path filePath = FileDialogs::OpenFile(L"Game Boy Rom\0*.gb"));
 
-	std::unique_ptr<GamboCore> gambo;
+	std::unique_ptr<GamboThread> gambo;
 	SDL_Texture* gamboScreen = nullptr;
 	SDL_Texture* gamboVramView = nullptr;
 	SDL_Window* window = nullptr;
 	SDL_Renderer* renderer = nullptr;
 
 	bool done = false;
+	int pixelScale = 5;
 	bool integerScale = true;
 	bool maintainAspectRatio = true;
 
+	std::filesystem::path romPath;	// of the cartridge that's in, empty if there isn't one
+
+	u8 joypad = 0;					// last buttons sent to the core
+
+	bool fastForwardToggled = false;
+	bool fastForwardActive = false;	// last fast forward state sent to the core
+	int fastForwardSpeed = 4;		// multiple of real hardware speed. 0 is unlimited.
+	int frameSkip = 4;				// only publish every Nth frame while fast forwarding
+	bool rewindActive = false;		// last rewind state sent to the core
+	int rewindBudget = (int)(GamboThread::DefaultRewindBudget / (1024 * 1024));	// megabytes, 0 turns rewind off
+	int runAhead = 0;				// frames shown ahead of the real one
+
+	std::vector<Breakpoint> breakpoints;	// mirrors the core's list, in the same order
+	Breakpoint newBreakpoint;
+	int breakOnInterrupts = 0;
+
 	// helpers
 	void DrawGamboWindow();
 	void DrawCPUInfoWindow();
 	void DrawVramViewer();
+	void DrawBreakpointsWindow();
+	void AddBreakpoint(const Breakpoint& b);
 	void SetGamboRunning();
 	void SetGamboStep();
 	void SetGamboStepFrame();
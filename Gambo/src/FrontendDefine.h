@@ -0,0 +1,38 @@
+#pragma once
+#include "SDL.h"
+#pragma comment(lib, "SDL2.lib")
+#pragma comment(lib, "SDL2main.lib")
+
+#define IMGUI_DEFINE_MATH_OPERATORS
+#include "imgui.h"
+#include "imgui_internal.h"
+
+#include "GamboDefine.h"
+
+inline constexpr auto PixelScaleMax = 8;
+
+static const ImVec4
+	GREY				{ 0.75, 0.75, 0.75, 1 },
+	DARK_GREY			{ 0.5, 0.5, 0.5, 1 },
+	VERY_DARK_GREY		{ 0.25, 0.25, 0.25, 1 },
+	RED					{ 1, 0, 0, 1 },
+	DARK_RED			{ 0.5, 0, 0, 1 },
+	VERY_DARK_RED		{ 0.25, 0, 0, 1 },
+	YELLOW				{ 1, 1, 0, 1 },
+	DARK_YELLOW			{ 0.5, 0.5, 0, 1 },
+	VERY_DARK_YELLOW	{ 0.25, 0.25, 0, 1 },
+	GREEN				{ 0, 1, 0, 1 },
+	DARK_GREEN			{ 0, 0.5, 0, 1 },
+	VERY_DARK_GREEN		{ 0, 0.25, 0, 1 },
+	CYAN				{ 0, 1, 1, 1 },
+	DARK_CYAN			{ 0, 0.5, 0.5, 1 },
+	VERY_DARK_CYAN		{ 0, 0.25, 0.25, 1 },
+	BLUE				{ 0, 0, 1, 1 },
+	DARK_BLUE			{ 0, 0, 0.5, 1 },
+	VERY_DARK_BLUE		{ 0, 0, 0.25, 1 },
+	MAGENTA				{ 1, 0, 1, 1 },
+	DARK_MAGENTA		{ 0.5, 0, 0.5, 1 },
+	VERY_DARK_MAGENTA	{ 0.25, 0, 0.25, 1 },
+	WHITE				{ 1, 1, 1, 1 },
+	BLACK				{ 0, 0, 0, 1 },
+	BLANK				{ 0, 0, 0, 0 };
@@ -0,0 +1,85 @@
+#include "GamboAPI.h"
+#include "GamboCore.h"
+#include "Cartridge.h"
+#include "Trace.h"
+
+struct Gambo
+{
+	GamboCore core;
+};
+
+Gambo* Gambo_Create(int useBootRom)
+{
+	Gambo* gambo = new Gambo();
+	gambo->core.SetUseBootRom(useBootRom != 0);
+	gambo->core.Reset();
+	return gambo;
+}
+
+void Gambo_Destroy(Gambo* gambo)
+{
+	SAFE_DELETE(gambo);
+}
+
+int Gambo_LoadRom(Gambo* gambo, const char* path)
+{
+	gambo->core.InsertCartridge(path);
+
+	auto& cart = gambo->core.GetCartridge();
+	return cart.IsLoaded() && cart.IsMapperSupported();
+}
+
+void Gambo_Reset(Gambo* gambo)
+{
+	gambo->core.Reset();
+}
+
+void Gambo_RunFrame(Gambo* gambo)
+{
+	gambo->core.RunFrame();
+}
+
+const uint8_t* Gambo_GetFramebuffer(const Gambo* gambo)
+{
+	return static_cast<const uint8_t*>(gambo->core.GetScreen());
+}
+
+void Gambo_SetJoypad(Gambo* gambo, uint8_t buttons)
+{
+	gambo->core.SetJoypad(buttons);
+}
+
+void Gambo_SetRandomSeed(Gambo* gambo, uint32_t seed)
+{
+	gambo->core.SetRandomSeed(seed);
+}
+
+void Gambo_RunFramesParallel(Gambo* const* gambos, int count, int frames, int threads)
+{
+	std::vector<GamboCore*> cores(count);
+	for (int i = 0; i < count; i++)
+		cores[i] = &gambos[i]->core;
+
+	GamboCore::RunParallel(cores, frames, threads);
+}
+
+void Gambo_SetTraceSize(Gambo* gambo, uint32_t entries)
+{
+	gambo->core.SetTraceSize(entries);
+}
+
+int Gambo_SaveTrace(const Gambo* gambo, const char* path)
+{
+	auto trace = gambo->core.GetTrace();
+	return trace && trace->Save(path);
+}
+
+int Gambo_SaveState(const Gambo* gambo, const char* path)
+{
+	return gambo->core.SaveStateFile(path);
+}
+
+int Gambo_LoadState(Gambo* gambo, const char* path)
+{
+	return gambo->core.LoadStateFile(path);
+}
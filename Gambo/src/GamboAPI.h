@@ -0,0 +1,65 @@
+#pragma once
+#include <stdint.h>
+
+// plain c interface to the emulator core. this has no dependency on sdl or
+// imgui so it can be used from headless tools, test harnesses, or other
+// languages.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct Gambo Gambo;
+
+#define GAMBO_SCREEN_WIDTH		160
+#define GAMBO_SCREEN_HEIGHT		144
+#define GAMBO_BYTES_PER_PIXEL	4
+
+// joypad bits for Gambo_SetJoypad
+#define GAMBO_BUTTON_RIGHT		(1 << 0)
+#define GAMBO_BUTTON_LEFT		(1 << 1)
+#define GAMBO_BUTTON_UP			(1 << 2)
+#define GAMBO_BUTTON_DOWN		(1 << 3)
+#define GAMBO_BUTTON_A			(1 << 4)
+#define GAMBO_BUTTON_B			(1 << 5)
+#define GAMBO_BUTTON_SELECT		(1 << 6)
+#define GAMBO_BUTTON_START		(1 << 7)
+
+Gambo*			Gambo_Create(int useBootRom);
+void			Gambo_Destroy(Gambo* gambo);
+
+// returns 1 if the rom was loaded and its mapper is supported, 0 otherwise
+int				Gambo_LoadRom(Gambo* gambo, const char* path);
+void			Gambo_Reset(Gambo* gambo);
+
+// runs the core until the next vblank
+void			Gambo_RunFrame(Gambo* gambo);
+
+// GAMBO_SCREEN_WIDTH * GAMBO_SCREEN_HEIGHT pixels, rgba32, row major
+const uint8_t*	Gambo_GetFramebuffer(const Gambo* gambo);
+
+// bitwise or of GAMBO_BUTTON_* for every button held down
+void			Gambo_SetJoypad(Gambo* gambo, uint8_t buttons);
+
+// makes the power on contents of WRAM reproducible. applies on the next
+// Gambo_Reset or Gambo_LoadRom.
+void			Gambo_SetRandomSeed(Gambo* gambo, uint32_t seed);
+
+// runs each core for the given number of frames on a pool of worker threads.
+// threads == 0 uses one per hardware thread. a core must not be used by the
+// caller until this returns.
+void			Gambo_RunFramesParallel(Gambo* const* gambos, int count, int frames, int threads);
+
+// records the last entries instructions in a ring buffer, 0 turns it off.
+// Gambo_SaveTrace writes them out for the gambo_trace tool, returns 1 on success.
+void			Gambo_SetTraceSize(Gambo* gambo, uint32_t entries);
+int				Gambo_SaveTrace(const Gambo* gambo, const char* path);
+
+// a snapshot of the whole machine. loading only works with the rom the state
+// was saved from still loaded. both return 1 on success.
+int				Gambo_SaveState(const Gambo* gambo, const char* path);
+int				Gambo_LoadState(Gambo* gambo, const char* path);
+
+#ifdef __cplusplus
+}
+#endif
@@ -3,23 +3,30 @@
 #include "PPU.h"
 #include "RAM.h"
 #include "Input.h"
+#include "InterruptController.h"
 #include "Cartridge.h"
 #include "BootRomDMG.h"
 #include "VramViewer.h"
+#include "Trace.h"
+#include "Profiler.h"
+#include "SaveState.h"
 
 #include <fstream>
 #include <random>
-#include <format>
 #include <iostream>
+#include <thread>
 
 GamboCore::GamboCore()
 	: ram(new RAM(this))
 	, cpu(new CPU(this))
 	, ppu(new PPU(this))
 	, input(new Input(this))
+	, interrupts(new InterruptController(this))
 	, boot(new BootRomDMG())
 	, cart(new Cartridge())
 	, vram(new VramViewer(ram))
+	, disassembler(new Disassembler(this))
+	, memoryMap(this)
 {
 	cart->Reset();
 	Reset();
@@ -31,69 +38,130 @@ GamboCore::~GamboCore()
 	SAFE_DELETE(ppu);
 	SAFE_DELETE(ram);
 	SAFE_DELETE(input);
+	SAFE_DELETE(interrupts);
 	SAFE_DELETE(cart);
 	SAFE_DELETE(boot);
+	SAFE_DELETE(disassembler);
+	SAFE_DELETE(trace);
+	SAFE_DELETE(profiler);
 }
 
-void GamboCore::Run()
+void GamboCore::RunFrame()
 {
-	if (running)
+	// give up on the frame if the lcd doesn't get to vblank within 10 frames worth of cycles
+	scheduler.Schedule(SchedulerEvent::FrameLimit, scheduler.GetNow() + 702240 + 1);
+	input->Check();
+
+	if (breakpoints.IsHit())
+		breakpoints.Continue(cpu->GetPC());
+
+	while (!Step())
 	{
-		bool vblank = false;
-		int totalCycles = 0;
-		while (!vblank)
+		if (breakpoints.IsHit())
 		{
-			input->Check();
-			int cycles = cpu->RunFor(1);
-			vblank = ppu->Tick(cycles);
-
-			totalCycles += cycles;
-			if (totalCycles > 702240)
-				vblank = true;
-
-			//if (cpu->GetPC() == 0x00A4)
-			//{
-			//	running = false;
-			//	break;
-			//}
+			// leave everything up to date for the debugger
+			SyncComponents();
+			break;
 		}
-		
-		disassemble = true;
 	}
-	else if (step)
+
+	scheduler.Cancel(SchedulerEvent::FrameLimit);
+
+	// leave the timer registers up to date for anything looking at memory between frames
+	cpu->SyncTimers();
+}
+
+void GamboCore::StepInstruction()
+{
+	// stepping always runs the instruction in front of us
+	if (breakpoints.IsArmed())
+		breakpoints.Continue(cpu->GetPC());
+
+	do
 	{
-		do
-		{
-			int cycles = cpu->RunFor(1);
-			ppu->Tick(cycles);
-		} while (!cpu->IsCurrentInstructionFinished());
+		Step();
+	} while (!cpu->IsCurrentInstructionFinished());
 
-		step = false;
-		disassemble = true;
-	}
-	else if (stepFrame)
+	// leave everything up to date for the debugger
+	SyncComponents();
+	cpu->SyncTimers();
+}
+
+bool GamboCore::Step()
+{
+	int cycles = cpu->RunFor(1);
+	scheduler.Advance(cycles);
+
+	if (scheduler.IsDue() || syncRequested)
+		return SyncComponents(cycles);
+
+	return false;
+}
+
+bool GamboCore::SyncComponents(int lastStep)
+{
+	u64 now = scheduler.GetNow();
+	int quiet = (int)(now - syncedTo) - lastStep;
+	syncedTo = now;
+
+	// a sync from inside a step doesn't cover the step itself
+	if (lastStep > 0)
+		syncRequested = false;
+
+	// nothing happens in the quiet cycles, so they can be run in one go
+	bool vblank = false;
+	if (quiet > 0)
+		vblank |= ppu->Tick(quiet);
+
+	if (lastStep > 0)
+		vblank |= ppu->Tick(lastStep);
+
+	// the timers keep to themselves until TIMA overflows
+	if (scheduler.IsDue(SchedulerEvent::Timer))
+		cpu->SyncTimers();
+
+	input->Check();
+	ScheduleEvents();
+
+	return vblank || scheduler.IsDue(SchedulerEvent::FrameLimit);
+}
+
+void GamboCore::RequestSync()
+{
+	syncRequested = true;
+}
+
+void GamboCore::ScheduleEvents()
+{
+	scheduler.Schedule(SchedulerEvent::PPU, scheduler.GetNow() + std::max(ppu->GetCyclesUntilEvent(), 0));
+}
+
+void GamboCore::RunParallel(std::span<GamboCore* const> cores, int frames, unsigned threads)
+{
+	if (threads == 0)
+		threads = std::max(std::thread::hardware_concurrency(), 1u);
+	threads = (unsigned)std::min<size_t>(threads, cores.size());
+
+	// each worker grabs the next core nobody has run yet and runs all of its
+	// frames before moving on
+	std::atomic<size_t> next = 0;
+	auto worker = [&]()
 	{
-		bool vblank = false;
-		int totalCycles = 0;
-		while (!vblank)
+		for (size_t i = next++; i < cores.size(); i = next++)
 		{
-			int cycles = cpu->RunFor(1);
-			vblank = ppu->Tick(cycles);
-
-			totalCycles += cycles;
-			if (totalCycles > 702240)
-				vblank = true;
-
-			//if (cpu->GetPC() == 0x00A4)
-			//{
-			//	running = false;
-			//	break;
-			//}
+			for (int f = 0; f < frames; f++)
+				cores[i]->RunFrame();
 		}
+	};
 
-		stepFrame = false;
-		disassemble = true;
-	}
+	std::vector<std::thread> workers;
+	for (unsigned t = 1; t < threads; t++)
+		workers.emplace_back(worker);
+
+	worker();
+
+	for (auto& w : workers)
+		w.join();
 }
 
 const void* GamboCore::GetScreen() const
@@ -101,6 +169,16 @@ const void* GamboCore::GetScreen() const
 	return (void*)ppu->GetScreen().data();
 }
 
+void GamboCore::SetJoypad(u8 buttons)
+{
+	input->SetButtons(buttons);
+}
+
+void GamboCore::SetRendering(bool b)
+{
+	ppu->SetRendering(b);
+}
+
 VramViewer& GamboCore::GetVramViewer()
 {
 	return *vram;
@@ -108,12 +186,12 @@ VramViewer& GamboCore::GetVramViewer()
 
 float GamboCore::GetScreenWidth() const
 {
-	return screenWidth * screenScale;
+	return screenWidth;
 }
 
 float GamboCore::GetScreenHeight() const
 {
-	return screenHeight * screenScale;
+	return screenHeight;
 }
 
 GamboState GamboCore::GetState() const
@@ -143,79 +221,126 @@ GamboState GamboCore::GetState() const
 	g.IE = ram->Get(HWAddr::IE);
 	g.IF = ram->Get(HWAddr::IF);
 
-	if (disassemble)
-		g.mapAsm = Disassemble(g.PC, 10);
+	disassembler->Disassemble(g.PC, g.disassembly);
+	g.breakHit = breakpoints.GetHit();
 
 	return g;
 }
 
-bool GamboCore::GetDone()
+const Cartridge& GamboCore::GetCartridge() const
 {
-	return done;
+	return *cart;
 }
 
-void GamboCore::SetDone(bool b)
+void GamboCore::InsertCartridge(std::filesystem::path filePath)
 {
-	done = b;
+	Reset();
+
+	cart->Load(filePath);
+
+	// copy the first 2 rom banks of the cartridge data into ram
+	for (u16 i = 0; i < 32KiB; i++)
+		ram->Set(i, cart->Read(i));
+
+	memoryMap.MapCartridge();
 }
 
-bool GamboCore::GetRunning()
+void GamboCore::EjectCartridge()
 {
-	return running;
+	cart->Reset();
+	Reset();
 }
 
-void GamboCore::SetRunning(bool b)
+void GamboCore::SetUseBootRom(bool b)
 {
-	running = b;
+	useBootRom = b;
+	memoryMap.MapCartridge();
 }
 
-bool GamboCore::GetStep()
+bool GamboCore::IsUseBootRom()
 {
-	return step;
+	return useBootRom;
 }
 
-void GamboCore::SetStep(bool b)
+void GamboCore::SetRandomSeed(u32 seed)
 {
-	step = b;
+	ram->SetRandomSeed(seed);
 }
 
-bool GamboCore::GetStepFrame()
+void GamboCore::SetCPUBackend(CPUBackend backend)
 {
-	return stepFrame;
+	cpu->SetBackend(backend);
 }
 
-void GamboCore::SetStepFrame(bool b)
+void GamboCore::SetTraceSize(size_t entries)
 {
-	stepFrame = b;
+	cpu->SetTrace(nullptr);
+	SAFE_DELETE(trace);
+
+	if (entries > 0)
+	{
+		trace = new TraceBuffer(entries);
+		cpu->SetTrace(trace);
+	}
 }
 
-const Cartridge& GamboCore::GetCartridge() const
+const TraceBuffer* GamboCore::GetTrace() const
 {
-	return *cart;
+	return trace;
 }
 
-void GamboCore::InsertCartridge(std::filesystem::path filePath)
+void GamboCore::SetProfiling(bool enabled)
 {
-	Reset();
+	cpu->SetProfiler(nullptr);
+	SAFE_DELETE(profiler);
 
-	cart->Load(filePath);
+	if (enabled)
+	{
+		profiler = new Profiler(this);
+		cpu->SetProfiler(profiler);
+	}
+}
 
-	// copy the first 2 rom banks of the cartridge data into ram
-	for (u16 i = 0; i < 32KiB; i++)
-		ram->Set(i, cart->Read(i));
+Profiler* GamboCore::GetProfiler()
+{
+	return profiler;
 }
 
-void GamboCore::SetUseBootRom(bool b)
+void GamboCore::AddBreakpoint(const Breakpoint& b)
 {
-	useBootRom = b;
+	breakpoints.Add(b);
+	ArmBreakpoints();
+}
 
-	if (!running)
-		Reset();
+void GamboCore::RemoveBreakpoint(size_t index)
+{
+	breakpoints.Remove(index);
+	ArmBreakpoints();
 }
 
-bool GamboCore::IsUseBootRom()
+void GamboCore::ClearBreakpoints()
 {
-	return useBootRom;
+	breakpoints.Clear();
+	ArmBreakpoints();
+}
+
+void GamboCore::SetBreakOnInterrupts(u8 mask)
+{
+	breakpoints.SetInterruptMask(mask);
+	ArmBreakpoints();
+}
+
+const Breakpoints& GamboCore::GetBreakpoints() const
+{
+	return breakpoints;
+}
+
+void GamboCore::ArmBreakpoints()
+{
+	// watched pages are pulled out of the memory map so only they take the slow path
+	bool armed = breakpoints.IsArmed();
+	cpu->SetBreakpoints(armed ? &breakpoints : nullptr);
+	memoryMap.SetWatchedPages(armed ? &breakpoints.GetPages() : nullptr);
 }
 
 u8 GamboCore::Read(u16 addr)
@@ -246,33 +371,121 @@ void GamboCore::Write(u16 addr, u8 data)
 	else if (IsCartridgeAddress(addr))
 	{
 		if (cart->IsLoaded())
+		{
+			// possibly a bank switch
 			cart->Write(addr, data);
+			memoryMap.MapCartridge();
+		}
 		else
 			return;
 	}
 	else
 	{
 		ram->Write(addr, data);
+
+		// the boot rom unmaps itself by writing here
+		if (addr == HWAddr::BOOT)
+			memoryMap.MapCartridge();
 	}
 }
 
 void GamboCore::Reset()
 {
-	done = false;
-	running = false;
-	step = false;
+	scheduler.Reset();
+	syncedTo = 0;
+	syncRequested = false;
+
 	cpu->Reset();
 	ppu->Reset();
 	ram->Reset();
 	boot->Reset();
+	disassembler->Clear();
+	breakpoints.ClearHit();
+	interrupts->Refresh();
+	memoryMap.MapAll();
+	ScheduleEvents();
+	cpu->ScheduleTimer();
 
 	// resetting the cartridge is akin to removing a game from a physical gameboy
 	//cart->Reset();
 }
 
-std::map<u16, std::string> GamboCore::Disassemble(u16 startAddr, int numInstr) const
+void GamboCore::SaveState(std::vector<u8>& out) const
+{
+	out.clear();
+	StateWriter w(out);
+
+	StateHeader header = {};
+	header.magic = StateMagic;
+	header.version = StateVersion;
+	header.globalChecksum = cart->GetGlobalChecksum();
+	header.headerChecksum = cart->GetHeaderChecksum();
+	header.ramSize = (u32)cart->GetRamData().size();
+	w.Write(header);
+
+	cpu->SaveState(w);
+	ppu->SaveState(w);
+	ram->SaveState(w);
+	cart->SaveState(w);
+	scheduler.SaveState(w);
+	w.Write(syncedTo);
+	w.Write(syncRequested);
+
+	// the size goes in last, so a cut off state is caught before anything is loaded
+	u32 size = (u32)out.size();
+	std::memcpy(out.data() + offsetof(StateHeader, size), &size, sizeof(size));
+}
+
+bool GamboCore::LoadState(std::span<const u8> data)
+{
+	StateReader r(data);
+	auto header = r.Read<StateHeader>();
+	if (!r.IsGood() || header.magic != StateMagic || header.version != StateVersion || header.size != data.size())
+		return false;
+
+	if (header.globalChecksum != cart->GetGlobalChecksum() ||
+		header.headerChecksum != cart->GetHeaderChecksum() ||
+		header.ramSize != cart->GetRamData().size())
+		return false;
+
+	cpu->LoadState(r);
+	ppu->LoadState(r);
+	ram->LoadState(r);
+	cart->LoadState(r);
+	scheduler.LoadState(r);
+	r.Read(syncedTo);
+	r.Read(syncRequested);
+
+	// everything derived from what was just loaded
+	interrupts->Refresh();
+	memoryMap.MapAll();
+	breakpoints.ClearHit();
+	return true;
+}
+
+bool GamboCore::SaveStateFile(const std::filesystem::path& path) const
+{
+	std::vector<u8> state;
+	SaveState(state);
+
+	std::ofstream file(path, std::ios::binary);
+	file.write((const char*)state.data(), state.size());
+	return file.good();
+}
+
+bool GamboCore::LoadStateFile(const std::filesystem::path& path)
+{
+	std::ifstream file(path, std::ios::binary);
+	if (!file.is_open())
+		return false;
+
+	std::vector<u8> state((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	return LoadState(state);
+}
+
+void GamboCore::Disassemble(u16 addr, std::span<DisassemblyLine> lines)
 {
-	return cpu->Disassemble(startAddr, numInstr);
+	disassembler->Disassemble(addr, lines);
 }
 
 bool GamboCore::IsBootRomAddress(u16 addr)
@@ -286,5 +499,5 @@ bool GamboCore::IsCartridgeAddress(u16 addr)
 {
 	return
 		(0x0000 <= addr && addr <= 0x7FFF) ||	// rom
-		(0xA000 <= addr && addr <= 0xBFFF) && cart->GetRamSize() > 0;		// ram
+		(0xA000 <= addr && addr <= 0xBFFF) && cart->HasRam();		// ram
 }
\ No newline at end of file
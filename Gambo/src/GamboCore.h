@@ -1,12 +1,22 @@
 #pragma once
 #include "GamboDefine.h"
+#include "Scheduler.h"
+#include "MemoryMap.h"
+#include "Disassembler.h"
+#include "Breakpoints.h"
+#include <span>
 
 class CPU;
 class PPU;
 class RAM;
+class Input;
+class InterruptController;
 class Cartridge;
 class BootRom;
 class VramViewer;
+class TraceBuffer;
+class Profiler;
+enum class CPUBackend : u8;
 
 struct GamboState
 {
@@ -29,7 +39,8 @@ struct GamboState
 	u8 IE;
 	u8 IF;
 
-	std::map<uint16_t, std::string> mapAsm;
+	std::array<DisassemblyLine, 10> disassembly;
+	BreakHit breakHit;	// why the last RunFrame stopped early, if it did
 };
 
 class GamboCore
@@ -38,61 +49,135 @@ class GamboCore
 	friend class PPU;
 	friend class RAM;
 	friend class Input;
+	friend class InterruptController;
+	friend class MemoryMap;
+	friend class Disassembler;
+	friend class Profiler;
 
 public:
 	GamboCore();
 	~GamboCore();
 
-	void Run();
+	void RunFrame();
+	void StepInstruction();
+
+	// runs every core for the given number of frames, spread across worker
+	// threads. cores share no state, so the results match running them one at
+	// a time. threads == 0 uses one thread per hardware thread.
+	static void RunParallel(std::span<GamboCore* const> cores, int frames, unsigned threads = 0);
 	
 	u8 Read(u16 addr);
 	void Write(u16 addr, u8 data);
 	void Reset();
 
 	const void* GetScreen() const;
+	void SetJoypad(u8 buttons);
+
+	// frames run with rendering off leave the screen as it was. they're
+	// otherwise identical, for frames nobody is going to look at.
+	void SetRendering(bool b);
 	VramViewer& GetVramViewer();
 	float GetScreenWidth() const;
 	float GetScreenHeight() const;
 	GamboState GetState() const;
 
-	bool GetDone();
-	void SetDone(bool b);
-	bool GetRunning();
-	void SetRunning(bool b);
-	bool GetStep();
-	void SetStep(bool b);
-	bool GetStepFrame();
-	void SetStepFrame(bool b);
-
 	const Cartridge& GetCartridge() const;
 	void InsertCartridge(std::filesystem::path filePath);
+	void EjectCartridge();
 
 	void SetUseBootRom(bool b);
 	bool IsUseBootRom();
 
+	// makes the power on garbage in WRAM reproducible. takes effect on the
+	// next reset or cartridge insert.
+	void SetRandomSeed(u32 seed);
+
+	// the interpreter is slower but is the reference the cached backend is checked against
+	void SetCPUBackend(CPUBackend backend);
+
+	// keeps the last entries instructions in a ring buffer, 0 turns tracing
+	// off. the trace survives resets, so it can be saved after a crash.
+	void SetTraceSize(size_t entries);
+	const TraceBuffer* GetTrace() const;
+
+	// attributes cycles to rom addresses and call stacks. null while it's off.
+	void SetProfiling(bool enabled);
+	Profiler* GetProfiler();
+
+	// RunFrame stops early when one of these is hit. with none armed the cpu
+	// runs exactly as it would without them.
+	void AddBreakpoint(const Breakpoint& b);
+	void RemoveBreakpoint(size_t index);
+	void ClearBreakpoints();
+	void SetBreakOnInterrupts(u8 mask);
+	const Breakpoints& GetBreakpoints() const;
+
+
+	// a snapshot of the whole machine, cheap enough to take every frame. out
+	// is overwritten, reusing it avoids allocating. a state only loads into a
+	// core with the same cartridge inserted, LoadState returns false and
+	// leaves the core alone for anything else.
+	void SaveState(std::vector<u8>& out) const;
+	bool LoadState(std::span<const u8> data);
+	bool SaveStateFile(const std::filesystem::path& path) const;
+	bool LoadStateFile(const std::filesystem::path& path);
+
+	// fills lines with the instructions from addr on. the lines are cached, so
+	// this is cheap enough to call every frame.
+	void Disassemble(u16 addr, std::span<DisassemblyLine> lines);
+
 
 private:
-	std::map<u16, std::string> Disassemble(u16 startAddr, int numInstr) const;
+	static constexpr u32 StateMagic = 0x54534247; // "GBST"
+	static constexpr u16 StateVersion = 1;
+
+	struct StateHeader
+	{
+		u32 magic;
+		u16 version;
+		u16 globalChecksum;		// of the cartridge it was saved from
+		u8 headerChecksum;
+		std::array<u8, 3> unused;
+		u32 ramSize;			// cartridge ram
+		u32 size;				// of the whole state, header included
+	};
 
 	bool IsBootRomAddress(u16 addr);
 	bool IsCartridgeAddress(u16 addr);
 
-	std::atomic<bool> done;
-	std::atomic<bool> running;
-	std::atomic<bool> step;
-	std::atomic<bool> stepFrame;
+	// runs the cpu for one step. the ppu and timers are only caught up when
+	// one of them is due or the cpu touched their registers. returns true
+	// once the frame is finished.
+	bool Step();
+
+	// catches the ppu up to the master clock, and the timers if TIMA is due
+	// to overflow. lastStep is the step that was just run, it's ticked on its
+	// own so everything crosses its thresholds on the same step as it would
+	// ticking every step.
+	bool SyncComponents(int lastStep = 0);
+	void RequestSync();
+	void ScheduleEvents();
+	void ArmBreakpoints();
 
 	CPU* cpu;
 	PPU* ppu;
 	RAM* ram;
 	Input* input;
+	InterruptController* interrupts;
 	BootRom* boot;
 	Cartridge* cart;
 	VramViewer* vram;
+	Disassembler* disassembler;
+	TraceBuffer* trace = nullptr;
+	Profiler* profiler = nullptr;
+
+	Scheduler scheduler;
+	MemoryMap memoryMap;
+	Breakpoints breakpoints;
+	u64 syncedTo = 0;				// master clock time the ppu and timers have been run up to
+	bool syncRequested = false;
 	
 	float screenWidth = GamboScreenWidth;
 	float screenHeight = GamboScreenHeight;
-	int screenScale = PixelScale; 
-	bool disassemble = true;
-	bool useBootRom;
+	bool useBootRom = false;
 };
\ No newline at end of file
@@ -1,12 +1,4 @@
 #pragma once
-#include "SDL.h"
-#pragma comment(lib, "SDL2.lib")
-#pragma comment(lib, "SDL2main.lib")
-
-#define IMGUI_DEFINE_MATH_OPERATORS
-#include "imgui.h"
-#include "imgui_internal.h"
-
 #include <cstdint>
 #include <vector>
 #include <string>
@@ -110,8 +102,6 @@ inline constexpr auto GamboScreenHeight = 144;
 inline constexpr auto GamboScreenSize = GamboScreenWidth * GamboScreenHeight;
 inline constexpr auto GamboAspectRatio = (float)GamboScreenWidth / (float)GamboScreenHeight;
 inline constexpr auto BytesPerPixel = 4;
-static auto PixelScale = 5;
-inline constexpr auto PixelScaleMax = 8;
 static constexpr auto TabSizeInSpaces = 4;
 inline constexpr auto OAMSize = 0xFEA0 - 0xFE00;
 inline constexpr auto ObjWidth = 8;
@@ -119,32 +109,6 @@ inline constexpr auto ObjWidth = 8;
 #define SAFE_DELETE(ptr) if (ptr) { delete ptr; ptr = nullptr; }
 #define SAFE_DELETE_ARRAY(ptr) if (ptr) { delete[] ptr; ptr = nullptr; }
 
-static const ImVec4
-	GREY				{ 0.75, 0.75, 0.75, 1 },
-	DARK_GREY			{ 0.5, 0.5, 0.5, 1 },
-	VERY_DARK_GREY		{ 0.25, 0.25, 0.25, 1 },
-	RED					{ 1, 0, 0, 1 },
-	DARK_RED			{ 0.5, 0, 0, 1 },
-	VERY_DARK_RED		{ 0.25, 0, 0, 1 },
-	YELLOW				{ 1, 1, 0, 1 },
-	DARK_YELLOW			{ 0.5, 0.5, 0, 1 },
-	VERY_DARK_YELLOW	{ 0.25, 0.25, 0, 1 },
-	GREEN				{ 0, 1, 0, 1 },
-	DARK_GREEN			{ 0, 0.5, 0, 1 },
-	VERY_DARK_GREEN		{ 0, 0.25, 0, 1 },
-	CYAN				{ 0, 1, 1, 1 },
-	DARK_CYAN			{ 0, 0.5, 0.5, 1 },
-	VERY_DARK_CYAN		{ 0, 0.25, 0.25, 1 },
-	BLUE				{ 0, 0, 1, 1 },
-	DARK_BLUE			{ 0, 0, 0.5, 1 },
-	VERY_DARK_BLUE		{ 0, 0, 0.25, 1 },
-	MAGENTA				{ 1, 0, 1, 1 },
-	DARK_MAGENTA		{ 0.5, 0, 0.5, 1 },
-	VERY_DARK_MAGENTA	{ 0.25, 0, 0.25, 1 },
-	WHITE				{ 1, 1, 1, 1 },
-	BLACK				{ 0, 0, 0, 1 },
-	BLANK				{ 0, 0, 0, 0 };
-
 static inline std::string hex(uint32_t n, uint8_t d)
 {
 	std::string s(d, '0');
@@ -173,7 +137,17 @@ enum ColorIndex
 	Transparent // for use in sprites
 };
 
-static SDL_Color GameBoyColors[5]
+// rgba32 pixel. layout matches SDL_PIXELFORMAT_RGBA32 so frontends can upload
+// the screen buffer directly.
+struct Color
+{
+	u8 r, g, b, a;
+
+	constexpr bool operator==(const Color& other) const = default;
+};
+static_assert(sizeof(Color) == BytesPerPixel);
+
+inline constexpr Color GameBoyColors[5]
 {
 	{ 200, 200, 15, 255 },
 	{ 139, 172, 15, 255 },
@@ -0,0 +1,382 @@
+#include "GamboThread.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+GamboThread::GamboThread()
+	: gambo(new GamboCore())
+	, rewind(DefaultRewindBudget)
+{
+	thread = std::thread(&GamboThread::ThreadMain, this);
+}
+
+GamboThread::~GamboThread()
+{
+	Send({ GamboCommandType::Quit });
+	thread.join();
+
+	SAFE_DELETE(gambo);
+}
+
+void GamboThread::Send(GamboCommand command)
+{
+	{
+		std::lock_guard lock(commandMutex);
+		commands.push_back(std::move(command));
+		commandsSent++;
+	}
+	commandCV.notify_one();
+}
+
+void GamboThread::Flush()
+{
+	std::unique_lock lock(commandMutex);
+	u64 target = commandsSent;
+	flushCV.wait(lock, [&]() { return commandsHandled >= target; });
+}
+
+bool GamboThread::UpdateFrame()
+{
+	return frames.Update();
+}
+
+const GamboFrame& GamboThread::GetFrame() const
+{
+	return frames.GetReadBuffer();
+}
+
+bool GamboThread::IsRunning() const
+{
+	return running;
+}
+
+bool GamboThread::IsUseBootRom() const
+{
+	return useBootRom;
+}
+
+double GamboThread::GetAchievedSpeed() const
+{
+	return achievedSpeed;
+}
+
+double GamboThread::GetRewindSeconds() const
+{
+	return rewindFrames / GameBoyFramerate;
+}
+
+size_t GamboThread::GetRewindMemory() const
+{
+	return rewindMemory;
+}
+
+double GamboThread::GetRunAheadCost() const
+{
+	return runAheadCost;
+}
+
+GamboCore& GamboThread::GetCore()
+{
+	return *gambo;
+}
+
+void GamboThread::ThreadMain()
+{
+	using namespace std::chrono;
+	using clock = high_resolution_clock;
+	using seconds = duration<double>;
+
+	auto timePoint = clock::now();
+	auto speedSampleStart = clock::now();
+	int speedSampleFrames = 0;
+	double speedSampleRunAhead = 0.0;
+	int framesSincePublish = 0;
+
+	PublishFrame();
+
+	while (true)
+	{
+		// take everything queued so far. while paused there's nothing else to
+		// do, so sleep until the frontend sends something.
+		std::deque<GamboCommand> pending;
+		{
+			std::unique_lock lock(commandMutex);
+			if (!running)
+				commandCV.wait(lock, [&]() { return !commands.empty(); });
+
+			pending.swap(commands);
+		}
+
+		bool quit = false;
+		bool publish = false;
+		for (auto& command : pending)
+		{
+			publish |= HandleCommand(command);
+			quit |= command.type == GamboCommandType::Quit;
+		}
+
+		if (publish)
+			PublishFrame();
+
+		if (!pending.empty())
+		{
+			{
+				std::lock_guard lock(commandMutex);
+				commandsHandled += pending.size();
+			}
+			flushCV.notify_all();
+		}
+
+		if (quit)
+			return;
+
+		if (!running)
+		{
+			// don't try to catch up on the time spent paused
+			timePoint = clock::now();
+			speedSampleStart = timePoint;
+			speedSampleFrames = 0;
+			speedSampleRunAhead = 0.0;
+			achievedSpeed = 0.0;
+			runAheadCost = 0.0;
+			continue;
+		}
+
+		// rewinding goes back at normal speed
+		int speed = fastForward && !rewinding ? fastForwardSpeed : 1;
+		int skip = fastForward && !rewinding ? frameSkip : 1;
+		bool present = framesSincePublish + 1 >= skip;
+
+		if (rewinding)
+		{
+			StepBack();
+		}
+		else
+		{
+			// what the real frame draws is never shown when running ahead
+			bool ahead = CanRunAhead();
+			gambo->SetRendering(!ahead);
+			gambo->RunFrame();
+			gambo->SetRendering(true);
+
+			if (gambo->GetBreakpoints().IsHit())
+			{
+				// stay where the breakpoint stopped us and show it
+				running = false;
+				PublishFrame();
+				framesSincePublish = 0;
+				continue;
+			}
+
+			RecordRewind();
+
+			if (ahead && present)
+				speedSampleRunAhead += RunAhead();
+		}
+		speedSampleFrames++;
+
+		if (++framesSincePublish >= skip)
+		{
+			PublishFrame();
+			framesSincePublish = 0;
+		}
+
+		// limit fps
+		if (speed != UnlimitedSpeed)
+		{
+			timePoint += duration_cast<clock::duration>(seconds{ 1.0 / (GameBoyFramerate * speed) });
+
+			// if we fell too far behind (slow machine, debugger, speed change) start
+			// pacing from now instead of running flat out to catch up
+			if (clock::now() - timePoint > 100ms)
+				timePoint = clock::now();
+
+			std::this_thread::sleep_until(timePoint - 5ms);
+			while (clock::now() <= timePoint)
+			{
+				// wait
+			}
+		}
+		else
+		{
+			timePoint = clock::now();
+		}
+
+		// measure how fast the core is running compared to real hardware
+		auto sampleTime = duration_cast<seconds>(clock::now() - speedSampleStart).count();
+		if (sampleTime >= 0.5)
+		{
+			achievedSpeed = (speedSampleFrames / sampleTime) / GameBoyFramerate;
+			runAheadCost = speedSampleRunAhead * 1000.0 / speedSampleFrames;
+			speedSampleStart = clock::now();
+			speedSampleFrames = 0;
+			speedSampleRunAhead = 0.0;
+		}
+	}
+}
+
+bool GamboThread::HandleCommand(const GamboCommand& command)
+{
+	// returns true if the command changed what the frontend should show
+	switch (command.type)
+	{
+	case GamboCommandType::Play:
+		running = true;
+		return false;
+
+	case GamboCommandType::Pause:
+		running = false;
+		return true;
+
+	case GamboCommandType::Step:
+		running = false;
+		gambo->StepInstruction();
+		return true;
+
+	case GamboCommandType::StepFrame:
+		running = false;
+		gambo->RunFrame();
+		return true;
+
+	case GamboCommandType::Reset:
+		running = false;
+		gambo->Reset();
+		return true;
+
+	case GamboCommandType::InsertCartridge:
+		running = false;
+		gambo->InsertCartridge(command.path);
+		rewind.Clear();
+		return true;
+
+	case GamboCommandType::EjectCartridge:
+		running = false;
+		gambo->EjectCartridge();
+		rewind.Clear();
+		return true;
+
+	case GamboCommandType::SetUseBootRom:
+		useBootRom = command.value != 0;
+		gambo->SetUseBootRom(useBootRom);
+		if (!running)
+			gambo->Reset();
+		return !running;
+
+	case GamboCommandType::SetJoypad:
+		gambo->SetJoypad((u8)command.value);
+		return false;
+
+	case GamboCommandType::SetFastForward:
+		fastForward = command.value != 0;
+		return false;
+
+	case GamboCommandType::SetFastForwardSpeed:
+		fastForwardSpeed = command.value;
+		return false;
+
+	case GamboCommandType::SetFrameSkip:
+		frameSkip = std::max(command.value, 1);
+		return false;
+
+	case GamboCommandType::AddBreakpoint:
+		gambo->AddBreakpoint(command.breakpoint);
+		return false;
+
+	case GamboCommandType::RemoveBreakpoint:
+		gambo->RemoveBreakpoint((size_t)command.value);
+		return false;
+
+	case GamboCommandType::ClearBreakpoints:
+		gambo->ClearBreakpoints();
+		return false;
+
+	case GamboCommandType::SetBreakOnInterrupts:
+		gambo->SetBreakOnInterrupts((u8)command.value);
+		return false;
+
+	case GamboCommandType::SaveState:
+		gambo->SaveStateFile(command.path);
+		return false;
+
+	case GamboCommandType::LoadState:
+		return gambo->LoadStateFile(command.path) && !running;
+
+	case GamboCommandType::SetRewinding:
+		rewinding = command.value != 0;
+		return false;
+
+	case GamboCommandType::SetRewindBudget:
+		rewind.SetBudget((size_t)command.value * 1024 * 1024);
+		rewindFrames = 0;
+		rewindMemory = 0;
+		return false;
+
+	case GamboCommandType::SetRunAhead:
+		runAhead = std::clamp(command.value, 0, MaxRunAhead);
+		return false;
+
+	case GamboCommandType::Quit:
+		running = false;
+		return false;
+	}
+
+	return false;
+}
+
+void GamboThread::RecordRewind()
+{
+	if (rewind.GetBudget() == 0)
+		return;
+
+	gambo->SaveState(rewindState);
+	rewind.Push(rewindState);
+	rewindFrames = rewind.GetCount();
+	rewindMemory = rewind.GetUsed();
+}
+
+void GamboThread::StepBack()
+{
+	// states don't have the screen in them, running the frame that came
+	// after the state draws it again. whatever that frame changed is thrown
+	// away by the next step back, or kept if this is where rewinding stops.
+	if (rewind.Pop(rewindState) && gambo->LoadState(rewindState))
+		gambo->RunFrame();
+
+	rewindFrames = rewind.GetCount();
+	rewindMemory = rewind.GetUsed();
+}
+
+bool GamboThread::CanRunAhead()
+{
+	// the debugging tools should only ever see frames that really happened
+	return runAhead > 0 && !gambo->GetBreakpoints().IsArmed() &&
+		gambo->GetTrace() == nullptr && gambo->GetProfiler() == nullptr;
+}
+
+double GamboThread::RunAhead()
+{
+	// runs the frames the game would show next if the buttons stayed as they
+	// are, so its reaction to them is on screen that much sooner. only the
+	// last one is drawn, then everything goes back to the real frame.
+	using clock = std::chrono::high_resolution_clock;
+	auto start = clock::now();
+
+	gambo->SaveState(runAheadState);
+	for (int i = 1; i <= runAhead; i++)
+	{
+		gambo->SetRendering(i == runAhead);
+		gambo->RunFrame();
+	}
+	gambo->SetRendering(true);
+	gambo->LoadState(runAheadState);
+
+	return std::chrono::duration<double>(clock::now() - start).count();
+}
+
+void GamboThread::PublishFrame()
+{
+	auto& frame = frames.GetWriteBuffer();
+	std::memcpy(frame.screen.data(), gambo->GetScreen(), sizeof(frame.screen));
+	frame.state = gambo->GetState();
+	frames.Publish();
+}
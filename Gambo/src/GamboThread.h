@@ -0,0 +1,128 @@
+#pragma once
+#include "GamboDefine.h"
+#include "GamboCore.h"
+#include "TripleBuffer.h"
+#include "Rewind.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+
+enum class GamboCommandType : u8
+{
+	Play,
+	Pause,
+	Step,
+	StepFrame,
+	Reset,
+	InsertCartridge,
+	EjectCartridge,
+	SetUseBootRom,
+	SetJoypad,
+	SetFastForward,
+	SetFastForwardSpeed,
+	SetFrameSkip,
+	AddBreakpoint,
+	RemoveBreakpoint,
+	ClearBreakpoints,
+	SetBreakOnInterrupts,
+	SaveState,
+	LoadState,
+	SetRewinding,
+	SetRewindBudget,
+	SetRunAhead,
+	Quit,
+};
+
+struct GamboCommand
+{
+	GamboCommandType type;
+	int value = 0;
+	std::filesystem::path path;
+	Breakpoint breakpoint;
+};
+
+// everything the frontend needs to draw one emulated frame
+struct GamboFrame
+{
+	std::array<Color, GamboScreenSize> screen;
+	GamboState state;
+};
+
+// runs a GamboCore on its own thread. the frontend talks to it only through
+// commands and picks up finished frames from a triple buffer, so a slow
+// present never stalls emulation and emulation never stalls the ui.
+class GamboThread
+{
+public:
+	GamboThread();
+	~GamboThread();
+
+	void Send(GamboCommand command);
+
+	// blocks until every command sent so far has been handled
+	void Flush();
+
+	// picks up the newest finished frame. returns true if it changed.
+	bool UpdateFrame();
+	const GamboFrame& GetFrame() const;
+
+	bool IsRunning() const;
+	bool IsUseBootRom() const;
+	double GetAchievedSpeed() const;
+
+	// how far back rewinding can go right now
+	double GetRewindSeconds() const;
+	size_t GetRewindMemory() const;
+
+	// milliseconds per frame spent on frames run ahead, 0 while it's off
+	double GetRunAheadCost() const;
+
+	// the core is owned by the emulation thread. only read things that don't
+	// change while it runs (like the cartridge header after Flush), or debug
+	// views that can tolerate a torn read.
+	GamboCore& GetCore();
+
+	static constexpr double GameBoyFramerate = 59.73;
+	static constexpr int UnlimitedSpeed = 0;
+	static constexpr size_t DefaultRewindBudget = 32 * 1024 * 1024;
+	static constexpr int MaxRunAhead = 4;
+
+private:
+	void ThreadMain();
+	bool HandleCommand(const GamboCommand& command);
+	void PublishFrame();
+	void RecordRewind();
+	void StepBack();
+	bool CanRunAhead();
+	double RunAhead();
+
+	GamboCore* gambo;
+	TripleBuffer<GamboFrame> frames;
+
+	std::mutex commandMutex;
+	std::condition_variable commandCV;
+	std::condition_variable flushCV;
+	std::deque<GamboCommand> commands;
+	u64 commandsSent = 0;
+	u64 commandsHandled = 0;
+
+	std::atomic<bool> running = false;
+	std::atomic<bool> useBootRom = false;
+	std::atomic<double> achievedSpeed = 0.0;
+	std::atomic<size_t> rewindFrames = 0;
+	std::atomic<size_t> rewindMemory = 0;
+	std::atomic<double> runAheadCost = 0.0;
+
+	// only touched by the emulation thread
+	bool fastForward = false;
+	int fastForwardSpeed = 4;
+	int frameSkip = 4;
+	bool rewinding = false;
+	RewindBuffer rewind;
+	std::vector<u8> rewindState;
+	int runAhead = 0;
+	std::vector<u8> runAheadState;
+
+	std::thread thread;
+};
@@ -0,0 +1,29 @@
+#include "InterruptController.h"
+#include "GamboCore.h"
+#include "RAM.h"
+
+InterruptController::InterruptController(GamboCore* c)
+	: core(c)
+{
+}
+
+InterruptController::~InterruptController()
+{
+}
+
+void InterruptController::Request(InterruptFlags f)
+{
+	core->ram->Get(HWAddr::IF) |= f;
+	Refresh();
+}
+
+void InterruptController::Acknowledge(InterruptFlags f)
+{
+	core->ram->Get(HWAddr::IF) &= ~f;
+	Refresh();
+}
+
+void InterruptController::Refresh()
+{
+	pending = core->ram->Get(HWAddr::IE) & core->ram->Get(HWAddr::IF) & 0b11111;
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include "GamboDefine.h"
+#include <bit>
+
+class GamboCore;
+
+// IE and IF stay in memory where the cpu reads them, but every change to
+// them goes through here so the interrupts that are both requested and
+// enabled are always known without looking at either register.
+class InterruptController
+{
+public:
+	InterruptController(GamboCore* c);
+	~InterruptController();
+
+	void Request(InterruptFlags f);
+	void Acknowledge(InterruptFlags f);
+
+	// recomputes the pending mask after IE or IF were written as memory
+	void Refresh();
+
+	bool IsPending() const
+	{
+		return pending != 0;
+	}
+
+	// the lowest bit has the highest priority
+	InterruptFlags GetHighestPriority() const
+	{
+		return pending ? (InterruptFlags)(1 << std::countr_zero(pending)) : InterruptFlags::None;
+	}
+
+private:
+	GamboCore* core;
+	u8 pending = 0;	// IE & IF
+};
@@ -0,0 +1,117 @@
+#include "MemoryMap.h"
+#include "GamboCore.h"
+#include "PPU.h"
+#include "RAM.h"
+#include "Cartridge.h"
+#include "Breakpoints.h"
+#include "bootroms/BootRom.h"
+#include <algorithm>
+
+// what the cpu reads from memory it can't access
+static constexpr auto OpenBus = []()
+{
+	std::array<u8, 256> page{};
+	page.fill(0xFF);
+	return page;
+}();
+
+MemoryMap::MemoryMap(GamboCore* c)
+	: core(c)
+{
+}
+
+void MemoryMap::MapAll()
+{
+	MapCartridge();
+	MapVideo();
+
+	// wram, and echo ram mirroring all but the last 512 bytes of it
+	u8* wram = &core->ram->Get(0xC000);
+	Map(0xC0, 0x20, wram, wram);
+	Map(0xE0, 0x1E, wram, wram);
+
+	// io, hram and IE share the last page, it always takes the slow path
+	Map(0xFF, 1, nullptr, nullptr);
+}
+
+void MemoryMap::SetWatchedPages(const std::array<u8, 256>* pages)
+{
+	watched = pages;
+	watchedReadPages.fill(nullptr);
+	watchedWritePages.fill(nullptr);
+	MapAll();
+}
+
+void MemoryMap::MapCartridge()
+{
+	const Cartridge& cart = *core->cart;
+
+	// rom. writes here are mapper registers.
+	for (u16 region = 0x0000; region < 0x8000; region += 16KiB)
+	{
+		const u8* rom = nullptr;
+		if (cart.IsLoaded())
+			rom = cart.GetRomBank(region);
+		else if (!core->IsUseBootRom())
+			rom = &core->ram->Get(region);
+
+		Map((u8)(region >> 8), 16KiB / 256, rom, nullptr);
+	}
+
+	if (core->IsBootRomAddress(0x0000))
+		Map(0x00, 1, core->boot->GetData(), nullptr);
+
+	// cartridge ram is whichever bank the mapper has enabled. while it's
+	// disabled the slow path hands out open bus. without any this is plain memory.
+	u8* ram = cart.HasRam() ? cart.GetRamBank() : &core->ram->Get(0xA000);
+	Map(0xA0, 0x20, ram, ram);
+}
+
+void MemoryMap::MapVideo()
+{
+	const PPU& ppu = *core->ppu;
+	bool scanning = ppu.IsEnabled() && ppu.GetMode() == PPUMode::OAMScan;
+	bool drawing = ppu.IsEnabled() && ppu.GetMode() == PPUMode::Draw;
+
+	// vram is locked while drawing
+	u8* vram = &core->ram->Get(0x8000);
+	if (drawing)
+		Map(0x80, 0x20, OpenBus.data(), ignoredWrites.data(), 0);
+	else
+		Map(0x80, 0x20, vram, vram);
+
+	// oam is locked during oam scan as well. it shares its page with the
+	// unusable area, which ignores writes anyway.
+	u8* oam = &core->ram->Get(HWAddr::OAM);
+	if (scanning || drawing)
+	{
+		std::fill_n(lockedOAM.begin(), OAMSize, 0xFF);
+		std::copy(oam + OAMSize, oam + 256, lockedOAM.begin() + OAMSize);
+		Map(0xFE, 1, lockedOAM.data(), ignoredWrites.data());
+	}
+	else
+	{
+		Map(0xFE, 1, oam, nullptr);
+	}
+}
+
+void MemoryMap::Map(u8 firstPage, int pages, const u8* read, u8* write, int stride)
+{
+	for (int i = 0; i < pages; i++)
+	{
+		int page = firstPage + i;
+		readPages[page] = read ? read + i * stride : nullptr;
+		writePages[page] = write ? write + i * stride : nullptr;
+
+		if (watched)
+		{
+			u8 kinds = (*watched)[page];
+			watchedReadPages[page] = (kinds & (u8)BreakKind::Read) ? readPages[page] : nullptr;
+			watchedWritePages[page] = (kinds & (u8)BreakKind::Write) ? writePages[page] : nullptr;
+			if (watchedReadPages[page])
+				readPages[page] = nullptr;
+			if (watchedWritePages[page])
+				writePages[page] = nullptr;
+		}
+	}
+}
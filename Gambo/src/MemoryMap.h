@@ -0,0 +1,61 @@
+#pragma once
+#include "GamboDefine.h"
+
+class GamboCore;
+
+// the cpu's view of the address space, one entry per 256 byte page. pages
+// backed by plain memory are read and written straight through a host
+// pointer. null entries go through the slow path, which handles io, mapper
+// registers and cartridge ram. while the ppu has vram or oam locked their
+// pages read 0xFF and write into a scratch page nobody reads. pages with a
+// watchpoint are left null as well, the memory behind them is kept aside
+// for the slow path to use once it has checked the access.
+class MemoryMap
+{
+public:
+	MemoryMap(GamboCore* c);
+
+	const u8* GetReadPage(u16 addr) const
+	{
+		return readPages[addr >> 8];
+	}
+
+	u8* GetWritePage(u16 addr) const
+	{
+		return writePages[addr >> 8];
+	}
+
+	// null for pages that aren't watched
+	const u8* GetWatchedReadPage(u16 addr) const
+	{
+		return watchedReadPages[addr >> 8];
+	}
+
+	u8* GetWatchedWritePage(u16 addr) const
+	{
+		return watchedWritePages[addr >> 8];
+	}
+
+	// BreakKind bits per page, null when nothing is watched. remaps everything.
+	void SetWatchedPages(const std::array<u8, 256>* pages);
+
+	// each of these has to be called when what's behind its pages changes
+	void MapAll();
+	void MapCartridge();	// bank switch, boot rom unmapped, cartridge inserted
+	void MapVideo();		// lcd turned on or off, ppu mode change
+
+private:
+	// stride is how far apart consecutive pages are in host memory. 0 maps
+	// the same page over and over.
+	void Map(u8 firstPage, int pages, const u8* read, u8* write, int stride = 256);
+
+	GamboCore* core;
+	std::array<const u8*, 256> readPages{};
+	std::array<u8*, 256> writePages{};
+	std::array<const u8*, 256> watchedReadPages{};
+	std::array<u8*, 256> watchedWritePages{};
+	const std::array<u8, 256>* watched = nullptr;
+
+	std::array<u8, 256> lockedOAM;	// 0xFF over oam, the unusable area behind it still reads as normal
+	std::array<u8, 256> ignoredWrites;
+};
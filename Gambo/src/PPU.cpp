@@ -3,9 +3,11 @@
 #include "GamboCore.h"
 #include "CPU.h"
 #include "RAM.h"
+#include "SaveState.h"
 #include <random>
+#include <algorithm>
 
-SDL_Color blankingColor = { 255, 255, 255, 255 };
+static constexpr Color blankingColor = { 255, 255, 255, 255 };
 
 PPU::PPU(GamboCore* c)
 	: core(c)
@@ -31,7 +33,7 @@ u8& PPU::Get(u16 addr)
 	return core->ram->Get(addr);
 }
 
-bool PPU::Tick(u8 cycles)
+bool PPU::Tick(int cycles)
 {
 	const u8& LCDC	= Get(HWAddr::LCDC);
 	const u8& DMA	= Get(HWAddr::DMA);
@@ -65,13 +67,13 @@ bool PPU::Tick(u8 cycles)
 				if (cyclesCounter >= 204)
 				{
 					cyclesCounter -= 204;
-					mode = PPUMode::OAMScan;
+					SetMode(PPUMode::OAMScan);
 					LY++;
 
 					if (LY == 144)
 					{
 						blankFrame = false;
-						mode = PPUMode::VBlank;
+						SetMode(PPUMode::VBlank);
 						modeCounterForVBlank = cyclesCounter;
 						core->cpu->RequestInterrupt(InterruptFlags::VBlank);
 
@@ -107,7 +109,7 @@ bool PPU::Tick(u8 cycles)
 				if (cyclesCounter >= 4560)
 				{
 					cyclesCounter -= 4560;
-					mode = PPUMode::OAMScan;
+					SetMode(PPUMode::OAMScan);
 					if (GetBits(STAT, (u8)STATBits::Mode2StatInterruptEnable, 0b1))
 						core->cpu->RequestInterrupt(InterruptFlags::LCDStat);
 				}
@@ -119,7 +121,7 @@ bool PPU::Tick(u8 cycles)
 				{
 					cyclesCounter -= 80;
 					SCX = Get(HWAddr::SCX);
-					mode = PPUMode::Draw;
+					SetMode(PPUMode::Draw);
 					scanlineComplete = false;
 
 					// 8x8 or 8x16?
@@ -137,7 +139,7 @@ bool PPU::Tick(u8 cycles)
 							objsToDraw.push_back(entry);
 
 							// only draw the first ten entries per scaline
-							if (objsToDraw.size() >= 10)
+							if (objsToDraw.size() >= MaxObjsPerLine)
 								break;
 						}
 					}
@@ -148,7 +150,7 @@ bool PPU::Tick(u8 cycles)
 			}
 			case PPUMode::Draw:
 			{
-				if (pixelCounter < GamboScreenWidth && LY <= GamboScreenHeight)
+				if (pixelCounter < GamboScreenWidth && LY <= GamboScreenHeight && render)
 				{
 					for (int i = 0; i < cycles; i++)
 					{
@@ -159,6 +161,12 @@ bool PPU::Tick(u8 cycles)
 							break;
 					}
 				}
+				else if (pixelCounter < GamboScreenWidth && LY <= GamboScreenHeight)
+				{
+					pixelCounter = std::min(pixelCounter + cycles, GamboScreenWidth);
+					if (pixelCounter >= GamboScreenWidth)
+						SkipLine();
+				}
 
 				if (cyclesCounter >= GamboScreenWidth && !scanlineComplete)
 				{
@@ -169,7 +177,7 @@ bool PPU::Tick(u8 cycles)
 				{
 					pixelCounter = 0;
 					cyclesCounter -= 172;
-					mode = PPUMode::HBlank;
+					SetMode(PPUMode::HBlank);
 
 					if (GetBits(STAT, (u8)STATBits::Mode0StatInterruptEnable, 0b1))
 						core->cpu->RequestInterrupt(InterruptFlags::LCDStat);
@@ -196,6 +204,77 @@ bool PPU::Tick(u8 cycles)
 	return vblank;
 }
 
+int PPU::GetCyclesUntilEvent() const
+{
+	// mirrors the thresholds in Tick
+	if (!isEnabled)
+		return 70224 - cyclesCounter;
+
+	switch (mode)
+	{
+		case PPUMode::HBlank:
+			return 204 - cyclesCounter;
+
+		case PPUMode::OAMScan:
+			return 80 - cyclesCounter;
+
+		case PPUMode::Draw:
+			return 172 - cyclesCounter;
+
+		case PPUMode::VBlank:
+		{
+			int cycles = std::min(456 - modeCounterForVBlank, 4560 - cyclesCounter);
+			if (LY >= 154)
+				cycles = std::min(cycles, 4104 - cyclesCounter);
+			return cycles;
+		}
+	}
+
+	return 0;
+}
+
+void PPU::SaveState(StateWriter& w) const
+{
+	w.Write(mode);
+	w.Write(doDMATransfer);
+	w.Write(blankFrame);
+	w.Write(isEnabled);
+	w.Write(cyclesCounter);
+	w.Write(modeCounterForVBlank);
+	w.Write(pixelCounter);
+	w.Write(scanlineComplete);
+	w.Write(LY);
+	w.Write(windowLY);
+	w.Write(SCX);
+	w.Write(objHeight);
+
+	// always room for a full scanline of objects, so the size never changes
+	std::array<OAM_entry, MaxObjsPerLine> objs{};
+	std::copy(objsToDraw.begin(), objsToDraw.end(), objs.begin());
+	w.Write((u8)objsToDraw.size());
+	w.Write(objs);
+}
+
+void PPU::LoadState(StateReader& r)
+{
+	r.Read(mode);
+	r.Read(doDMATransfer);
+	r.Read(blankFrame);
+	r.Read(isEnabled);
+	r.Read(cyclesCounter);
+	r.Read(modeCounterForVBlank);
+	r.Read(pixelCounter);
+	r.Read(scanlineComplete);
+	r.Read(LY);
+	r.Read(windowLY);
+	r.Read(SCX);
+	r.Read(objHeight);
+
+	u8 count = std::min<u8>(r.Read<u8>(), MaxObjsPerLine);
+	auto objs = r.Read<std::array<OAM_entry, MaxObjsPerLine>>();
+	objsToDraw.assign(objs.begin(), objs.begin() + count);
+}
+
 void PPU::Reset()
 {
 	mode = PPUMode::VBlank;
@@ -208,17 +287,28 @@ void PPU::Reset()
 	scanlineComplete = false;
 	LY = 0; 
 	windowLY = 0;
+	SCX = 0;
+	objHeight = 8;
 	screen.fill(blankingColor);
 
 	Get(HWAddr::LY) = LY;
 	Get(HWAddr::STAT) = (Get(HWAddr::STAT) & 0b11111100) | ((u8)mode & 0b11);
+
+	core->memoryMap.MapVideo();
 }
 
-const std::array<SDL_Color, GamboScreenSize>& PPU::GetScreen() const
+const std::array<Color, GamboScreenSize>& PPU::GetScreen() const
 {
 	return screen;
 }
 
+void PPU::SetMode(PPUMode m)
+{
+	// oam and vram are locked depending on the mode
+	mode = m;
+	core->memoryMap.MapVideo();
+}
+
 void PPU::Enable()
 {
 	Reset();
@@ -243,6 +333,11 @@ PPUMode PPU::GetMode() const
 	return mode;
 }
 
+void PPU::SetRendering(bool b)
+{
+	render = b;
+}
+
 void PPU::SetDoDMATransfer(bool b)
 {
 	doDMATransfer = true;
@@ -344,6 +439,17 @@ void PPU::DrawBGOrWindowPixel()
 	}
 }
 
+void PPU::SkipLine()
+{
+	const u8& LCDC = Get(HWAddr::LCDC);	// LCD control
+	const u8& WY = Get(HWAddr::WY);		// window Y position
+
+	// same check DrawBGOrWindowPixel does on the last pixel
+	if (GetBits(LCDC, (u8)LCDCBits::BGAndWindowEnable, 0b1) && !blankFrame &&
+		GetBits(LCDC, (u8)LCDCBits::WindowEnable, 0b1) && WY <= LY)
+		windowLY++;
+}
+
 void PPU::DrawObjPixel()
 {
 	const u8& LCDC = Get(HWAddr::LCDC);	// LCD control
@@ -367,9 +473,9 @@ void PPU::DrawObjPixel()
 			{
 				// early out if BG is over Obj
 				if (GetBits(obj.flags, 7, 0b1) && (
-					*reinterpret_cast<u32*>(&screen[pixelIndex]) == *reinterpret_cast<u32*>(&GameBoyColors[1]) ||
-					*reinterpret_cast<u32*>(&screen[pixelIndex]) == *reinterpret_cast<u32*>(&GameBoyColors[2]) ||
-					*reinterpret_cast<u32*>(&screen[pixelIndex]) == *reinterpret_cast<u32*>(&GameBoyColors[3])))
+					screen[pixelIndex] == GameBoyColors[1] ||
+					screen[pixelIndex] == GameBoyColors[2] ||
+					screen[pixelIndex] == GameBoyColors[3]))
 				{
 					continue;
 				}
@@ -2,6 +2,8 @@
 #include "GamboDefine.h"
 
 class GamboCore;
+class StateWriter;
+class StateReader;
 
 enum class LCDCBits
 {
@@ -47,23 +49,38 @@ public:
 	PPU(GamboCore* c);
 	~PPU();
 
-	bool Tick(u8 cycles);
+	bool Tick(int cycles);
+
+	// cycles until the next mode or LY change, the only points where the ppu
+	// raises interrupts or ends a frame
+	int GetCyclesUntilEvent() const;
 	void Reset();
-	const std::array<SDL_Color, GamboScreenSize>& GetScreen() const;
+
+	// the screen isn't part of a state, the next frame draws over all of it
+	void SaveState(StateWriter& w) const;
+	void LoadState(StateReader& r);
+
+	const std::array<Color, GamboScreenSize>& GetScreen() const;
 	void Enable();
 	void Disable();
 	bool IsEnabled() const;
 	PPUMode GetMode() const;
 	void SetDoDMATransfer(bool b);
 
+	// with rendering off nothing is written to the screen, but everything the
+	// game can see (timing, interrupts, the window line) carries on the same
+	void SetRendering(bool b);
+
 private:
 	u8 Read(u16 addr);
 	void Write(u16 addr, u8 data);
 	u8& Get(u16 addr);
 
+	void SetMode(PPUMode m);
 	void CheckForLYCStatInterrupt();
 	void DrawBGOrWindowPixel(); // draw background
 	void DrawObjPixel(); // draw scanline
+	void SkipLine(); // what drawing the last pixel of a line does besides drawing
 
 	GamboCore* core;
 	PPUMode mode;
@@ -77,7 +94,8 @@ private:
 	int LY;							// this is read only which is why we keep a local copy and write it into ram
 	int windowLY;					// same as LY but for the window. internal only, meaning not accessible to any other components of the game boy.
 	int SCX;						// this is not read only, but it does have specific behaviour when it comes to reading
-	std::array<SDL_Color, GamboScreenSize> screen;
+	std::array<Color, GamboScreenSize> screen;
+	bool render = true;
 
 	struct OAM_entry
 	{
@@ -87,6 +105,7 @@ private:
 		u8 flags;
 	};
 
+	static constexpr u8 MaxObjsPerLine = 10;
 	std::vector<OAM_entry> objsToDraw;
 	u8 objHeight;
 };
\ No newline at end of file
@@ -0,0 +1,239 @@
+#include "Profiler.h"
+#include "GamboCore.h"
+#include "Cartridge.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <ostream>
+
+Profiler::Profiler(GamboCore* c)
+	: core(c)
+{
+	Clear();
+}
+
+Profiler::~Profiler()
+{
+}
+
+bool Profiler::LoadSymbols(const std::filesystem::path& path)
+{
+	std::ifstream file(path);
+	if (!file.is_open())
+		return false;
+
+	std::string line;
+	while (std::getline(file, line))
+	{
+		// comments start with ;
+		line = line.substr(0, line.find(';'));
+
+		unsigned bank = 0, addr = 0;
+		char name[256] = {};
+		if (std::sscanf(line.c_str(), "%x:%x %255s", &bank, &addr, name) == 3)
+		{
+			// everything outside of switchable rom is keyed as bank 0
+			if (addr < 0x4000 || addr > 0x7FFF)
+				bank = 0;
+
+			symbols[bank << 16 | addr] = name;
+		}
+	}
+
+	return true;
+}
+
+void Profiler::Clear()
+{
+	for (auto& page : hotSpots)
+		page.reset();
+
+	nodes.clear();
+	children.clear();
+	stack.clear();
+
+	// everything that runs outside of a call is attributed to the root
+	nodes.push_back({ ~0u, 0, 0 });
+	currentNode = 0;
+	currentPage = UnbankedPage;
+	currentAddr = 0;
+	hotSpots[currentPage] = std::make_unique<Page>();
+	totalCycles = 0;
+}
+
+void Profiler::BeginInstruction(u16 pc, u16 sp)
+{
+	currentPage = GetPage(pc);
+	currentAddr = pc;
+	instructionSP = sp;
+
+	if (!hotSpots[currentPage])
+		hotSpots[currentPage] = std::make_unique<Page>();
+}
+
+void Profiler::EndInstruction(u8 opcode, bool isCB, u16 pc, u16 sp)
+{
+	if (isCB)
+		return;
+
+	switch (opcode)
+	{
+		// CALL and RST push the return address when they're taken
+		case 0xC4: case 0xCC: case 0xCD: case 0xD4: case 0xDC:
+		case 0xC7: case 0xCF: case 0xD7: case 0xDF: case 0xE7: case 0xEF: case 0xF7: case 0xFF:
+			if (sp == (u16)(instructionSP - 2))
+				Call(pc, sp);
+			break;
+
+		// RET and RETI pop it. code that drops its return address by hand is
+		// unwound by the next RET further out.
+		case 0xC0: case 0xC8: case 0xC9: case 0xD0: case 0xD8: case 0xD9:
+			if (sp == (u16)(instructionSP + 2))
+			{
+				while (!stack.empty() && stack.back().sp < sp)
+					stack.pop_back();
+
+				currentNode = stack.empty() ? 0 : stack.back().node;
+			}
+			break;
+	}
+}
+
+void Profiler::Interrupt(u16 pc, u16 sp)
+{
+	Call(pc, sp);
+	BeginInstruction(pc, sp);
+}
+
+void Profiler::WriteCollapsedStacks(std::ostream& out) const
+{
+	for (u32 i = 0; i < nodes.size(); i++)
+	{
+		if (nodes[i].cycles == 0)
+			continue;
+
+		std::vector<std::string> names;
+		for (u32 n = i; n != 0; n = nodes[n].parent)
+			names.push_back(GetName(nodes[n].key));
+		names.push_back("root");
+
+		for (auto name = names.rbegin(); name != names.rend(); name++)
+			out << *name << (name + 1 != names.rend() ? ";" : " ");
+		out << nodes[i].cycles << "\n";
+	}
+}
+
+void Profiler::WriteHotSpots(std::ostream& out, size_t count) const
+{
+	struct HotSpot
+	{
+		u64 cycles;
+		u32 page;
+		u16 addr;
+	};
+
+	std::vector<HotSpot> spots;
+	for (u32 page = 0; page < hotSpots.size(); page++)
+	{
+		if (!hotSpots[page])
+			continue;
+
+		for (u16 i = 0; i < 16KiB; i++)
+		{
+			if (u64 cycles = hotSpots[page]->cycles[i])
+			{
+				// rom pages only know the offset into their bank, put back the
+				// region it was mapped at
+				u16 region = page == 0 ? 0x0000 : page < UnbankedPage ? 0x4000 : (page - UnbankedPage) << 14;
+				spots.push_back({ cycles, page, (u16)(region | i) });
+			}
+		}
+	}
+
+	count = std::min(count, spots.size());
+	std::partial_sort(spots.begin(), spots.begin() + count, spots.end(),
+		[](const HotSpot& a, const HotSpot& b) { return a.cycles > b.cycles; });
+
+	for (size_t i = 0; i < count; i++)
+	{
+		auto& spot = spots[i];
+		u32 bank = spot.page < UnbankedPage ? spot.page : 0;
+		char line[64];
+		std::snprintf(line, sizeof(line), "%12llu %6.2f%%  %02X:%04X  ",
+			(unsigned long long)spot.cycles, 100.0 * spot.cycles / std::max<u64>(totalCycles, 1), bank, spot.addr);
+		out << line << GetName(bank << 16 | spot.addr) << "\n";
+	}
+}
+
+u64 Profiler::GetTotalCycles() const
+{
+	return totalCycles;
+}
+
+u32 Profiler::GetPage(u16 addr) const
+{
+	if (addr <= 0x7FFF && core->cart->IsLoaded() && !core->IsBootRomAddress(addr))
+	{
+		u32 page = core->cart->GetRomOffset(addr) >> 14;
+		if (page < UnbankedPage)
+			return page;
+	}
+
+	return UnbankedPage + (addr >> 14);
+}
+
+u32 Profiler::GetKey(u16 addr) const
+{
+	// bank 0 outside of switchable rom, matching the symbol files
+	u32 page = GetPage(addr);
+	u32 bank = (0x4000 <= addr && addr <= 0x7FFF && page < UnbankedPage) ? page : 0;
+	return bank << 16 | addr;
+}
+
+void Profiler::Call(u16 target, u16 sp)
+{
+	// past MaxDepth (runaway recursion, or code that calls and never returns)
+	// new frames are attributed to the deepest one
+	u32 node = currentNode;
+	if (stack.size() < MaxDepth)
+	{
+		u32 key = GetKey(target);
+		u64 id = (u64)currentNode << 32 | key;
+
+		auto it = children.find(id);
+		if (it == children.end())
+		{
+			it = children.emplace(id, (u32)nodes.size()).first;
+			nodes.push_back({ key, currentNode, 0 });
+		}
+
+		node = it->second;
+	}
+
+	stack.push_back({ node, sp });
+	currentNode = node;
+}
+
+std::string Profiler::GetName(u32 key) const
+{
+	char s[32];
+
+	// the closest symbol at or before the address in the same bank
+	auto it = symbols.upper_bound(key);
+	if (it != symbols.begin())
+	{
+		--it;
+		if ((it->first >> 16) == (key >> 16))
+		{
+			u32 offset = key - it->first;
+			if (offset == 0)
+				return it->second;
+
+			std::snprintf(s, sizeof(s), "+%X", offset);
+			return it->second + s;
+		}
+	}
+
+	std::snprintf(s, sizeof(s), "%02X:%04X", key >> 16, key & 0xFFFF);
+	return s;
+}
@@ -0,0 +1,84 @@
+#pragma once
+#include "GamboDefine.h"
+#include <memory>
+#include <iosfwd>
+#include <unordered_map>
+
+class GamboCore;
+
+// attributes every cycle the cpu spends to the instruction it was spent on,
+// keyed by rom bank and address, and to the call stack it happened under.
+// call stacks are rebuilt from CALL/RST/RET/RETI and interrupt dispatch.
+// nothing is sampled, so the totals add up to the cycles that were run.
+class Profiler
+{
+public:
+	Profiler(GamboCore* c);
+	~Profiler();
+
+	// rgbds .sym file, "bank:addr name" per line
+	bool LoadSymbols(const std::filesystem::path& path);
+	void Clear();
+
+	// called by the cpu
+	void BeginInstruction(u16 pc, u16 sp);
+	void EndInstruction(u8 opcode, bool isCB, u16 pc, u16 sp);
+	void Interrupt(u16 pc, u16 sp);
+	void AddCycles(int cycles)
+	{
+		hotSpots[currentPage]->cycles[currentAddr & 0x3FFF] += cycles;
+		nodes[currentNode].cycles += cycles;
+		totalCycles += cycles;
+	}
+
+	// collapsed stacks, "outer;inner;innermost cycles" per line, the format
+	// flamegraph.pl, inferno and speedscope read
+	void WriteCollapsedStacks(std::ostream& out) const;
+
+	// the count most expensive instructions, most expensive first
+	void WriteHotSpots(std::ostream& out, size_t count) const;
+
+	u64 GetTotalCycles() const;
+
+	bool operator==(const Profiler& other) const = delete;
+
+private:
+	static constexpr u32 UnbankedPage = 0x200;
+	static constexpr size_t MaxDepth = 64;
+
+	struct Page
+	{
+		std::array<u64, 16KiB> cycles{};
+	};
+
+	struct Node
+	{
+		u32 key;		// bank << 16 | address of the routine
+		u32 parent;
+		u64 cycles;		// spent in the routine itself, not its callees
+	};
+
+	struct Frame
+	{
+		u32 node;
+		u16 sp;			// where the return address was pushed
+	};
+
+	u32 GetPage(u16 addr) const;
+	u32 GetKey(u16 addr) const;
+	void Call(u16 target, u16 sp);
+	std::string GetName(u32 key) const;
+
+	GamboCore* core;
+	std::array<std::unique_ptr<Page>, UnbankedPage + 4> hotSpots;
+	std::vector<Node> nodes;
+	std::unordered_map<u64, u32> children;	// parent << 32 | key -> node
+	std::vector<Frame> stack;
+	std::map<u32, std::string> symbols;
+
+	u32 currentPage = 0;
+	u16 currentAddr = 0;
+	u32 currentNode = 0;
+	u16 instructionSP = 0;
+	u64 totalCycles = 0;
+};
@@ -1,6 +1,8 @@
 #include "RAM.h"
 #include "GamboCore.h"
 #include "PPU.h"
+#include "InterruptController.h"
+#include "SaveState.h"
 #include <random>
 
 const std::array<u8, 256> bootRom = // this is a regular DMG boot rom. not DMG0.
@@ -28,6 +30,7 @@ const std::array<u8, 256> bootRom = // this is a regular DMG boot rom. not DMG0.
 
 RAM::RAM(GamboCore* c)
 	: core(c)
+	, seed(std::random_device()())
 {
 }
 
@@ -37,6 +40,10 @@ RAM::~RAM()
 
 const u8 RAM::Read(u16 addr) const
 {
+	// echo ram
+	if (0xE000 <= addr && addr <= 0xFDFF)
+		addr -= 0x2000;
+
 	return ram[addr];
 }
 
@@ -70,18 +77,19 @@ void RAM::Write(u16 addr, u8 data)
 			core->ppu->Disable();
 	}
 
-	ram[addr] = data;
+	// echo ram
+	if (0xE000 <= addr && addr <= 0xFDFF)
+		addr -= 0x2000;
 
-	// this is the implementation for echo ram
-	if (addr >= 0xE000 && addr <= 0xFDFF)
-		ram[addr - 0x2000] = data;
-	else if (addr >= 0xC000 && addr <= 0xDDFF)
-		ram[addr + 0x2000] = data;
+	ram[addr] = data;
 
 	// top 3 bits in IF are always read as 1
 	if (addr == HWAddr::IF)
 		ram[HWAddr::IF] |= 0b11100000;
 
+	if (addr == HWAddr::IF || addr == HWAddr::IE)
+		core->interrupts->Refresh();
+
 	// writing anything to the DIV register resets it to 0
 	if (addr == HWAddr::DIV)
 		ram[addr] = 0;
@@ -97,14 +105,29 @@ void RAM::Set(u16 addr, u8 data)
 	ram[addr] = data;
 }
 
+void RAM::SetRandomSeed(u32 s)
+{
+	seed = s;
+}
+
+void RAM::SaveState(StateWriter& w) const
+{
+	w.Write(ram);
+}
+
+void RAM::LoadState(StateReader& r)
+{
+	r.Read(ram);
+}
+
 void RAM::Reset()
 {
 	ram.fill(0x00);
 
 	// fill WRAM with random garbage
-	std::random_device rd;
+	std::mt19937 rng(seed);
 	for (size_t i = 0xC000; i < 0xE000; i++)
-		ram[i] = rd() % 0x100;
+		ram[i] = rng() % 0x100;
 	
 	// fill IO/control registers with 0xFF
 	for (size_t i = 0xFF00; i < 0x10000; i++)
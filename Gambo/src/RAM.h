@@ -3,6 +3,8 @@
 
 class GamboCore;
 class PPU;
+class StateWriter;
+class StateReader;
 
 // 64KB total system memory. memory is mapped:
 // 0000-3FFF | 16 KiB ROM bank 00			  | From cartridge, usually a fixed bank
@@ -32,9 +34,15 @@ public:
 	void Set(u16 addr, u8 data);
 
 	void Reset();
+	void SaveState(StateWriter& w) const;
+	void LoadState(StateReader& r);
+
+	// seed used to fill WRAM with garbage on reset
+	void SetRandomSeed(u32 s);
 
 private:
 	GamboCore* core;
+	u32 seed;
 	std::array<u8, 64KiB> ram;
 	u16 lastRead;
 	u16 lastWrite;
@@ -0,0 +1,276 @@
+#include "Rewind.h"
+#include <algorithm>
+#include <cstring>
+
+static void WriteVarint(std::vector<u8>& out, size_t v)
+{
+	while (v >= 0x80)
+	{
+		out.push_back((u8)(v | 0x80));
+		v >>= 7;
+	}
+	out.push_back((u8)v);
+}
+
+static size_t ReadVarint(const u8*& p)
+{
+	size_t v = 0;
+	for (int shift = 0; ; shift += 7)
+	{
+		u8 b = *p++;
+		v |= (size_t)(b & 0x7F) << shift;
+		if (!(b & 0x80))
+			return v;
+	}
+}
+
+RewindBuffer::RewindBuffer(size_t budget)
+{
+	SetBudget(budget);
+}
+
+bool RewindBuffer::Push(std::span<const u8> state)
+{
+	if (arena.empty())
+		return false;
+
+	// a different cartridge, nothing from before can be rebuilt against it
+	if (state.size() != stateSize)
+	{
+		Clear();
+		stateSize = state.size();
+	}
+
+	bool isKeyframe = count == 0 || sinceKeyframe >= KeyframeInterval;
+	Encode(state, isKeyframe ? nullptr : keyframe.data(), scratch);
+
+	size_t offset;
+	if (!Allocate(scratch.size(), isKeyframe, offset))
+	{
+		if (isKeyframe)
+			return false;
+
+		// the newest group filled the whole budget on its own, start over from this state
+		Clear();
+		stateSize = state.size();
+		isKeyframe = true;
+		Encode(state, nullptr, scratch);
+		if (!Allocate(scratch.size(), true, offset))
+			return false;
+	}
+
+	std::memcpy(&arena[offset], scratch.data(), scratch.size());
+	PushEntry({ offset, (u32)scratch.size(), isKeyframe });
+	tail = offset + scratch.size();
+	used += scratch.size();
+
+	if (isKeyframe)
+	{
+		keyframe.assign(state.begin(), state.end());
+		sinceKeyframe = 0;
+		groups++;
+	}
+	sinceKeyframe++;
+
+	return true;
+}
+
+bool RewindBuffer::Pop(std::vector<u8>& state)
+{
+	if (count == 0)
+		return false;
+
+	Entry e = GetEntry(count - 1);
+	state.resize(stateSize);
+	Decode({ &arena[e.offset], e.size }, e.keyframe ? nullptr : keyframe.data(), state);
+
+	count--;
+	tail = count ? e.offset : 0;
+	used -= e.size;
+	sinceKeyframe--;
+
+	if (e.keyframe && count > 0)
+	{
+		// what's left of the buffer is now headed by the group before, so
+		// its keyframe is the one new deltas are made against
+		groups--;
+		size_t i = count - 1;
+		while (!GetEntry(i).keyframe)
+			i--;
+
+		auto& k = GetEntry(i);
+		Decode({ &arena[k.offset], k.size }, nullptr, keyframe);
+		sinceKeyframe = (int)(count - i);
+	}
+	else if (e.keyframe)
+	{
+		groups = 0;
+	}
+
+	return true;
+}
+
+void RewindBuffer::Clear()
+{
+	tail = 0;
+	used = 0;
+	first = 0;
+	count = 0;
+	groups = 0;
+	stateSize = 0;
+	sinceKeyframe = 0;
+}
+
+void RewindBuffer::SetBudget(size_t budget)
+{
+	Clear();
+
+	// everything is allocated here, pushing and popping never allocates once
+	// the scratch buffers have grown to the size of a state
+	arena.clear();
+	arena.shrink_to_fit();
+	arena.resize(budget);
+}
+
+size_t RewindBuffer::GetBudget() const
+{
+	return arena.size();
+}
+
+size_t RewindBuffer::GetUsed() const
+{
+	return used;
+}
+
+size_t RewindBuffer::GetCount() const
+{
+	return count;
+}
+
+void RewindBuffer::Encode(std::span<const u8> state, const u8* base, std::vector<u8>& out)
+{
+	static constexpr u8 Zeroes[8] = {};
+	const u8* s = state.data();
+	size_t n = state.size();
+	auto changed = [&](size_t i) { return base ? s[i] != base[i] : s[i] != 0; };
+
+	out.clear();
+	size_t i = 0;
+	while (i < n)
+	{
+		// unchanged bytes, 8 at a time where possible
+		size_t start = i;
+		while (i + 8 <= n && std::memcmp(s + i, base ? base + i : Zeroes, 8) == 0)
+			i += 8;
+		while (i < n && !changed(i))
+			i++;
+		WriteVarint(out, i - start);
+
+		// changed bytes, up to the next gap long enough to be worth a new run
+		start = i;
+		size_t end = i;
+		while (i < n && i - end < 4)
+		{
+			if (changed(i))
+				end = i + 1;
+			i++;
+		}
+		i = end;
+
+		WriteVarint(out, end - start);
+		for (size_t j = start; j < end; j++)
+			out.push_back(base ? s[j] ^ base[j] : s[j]);
+	}
+}
+
+void RewindBuffer::Decode(std::span<const u8> data, const u8* base, std::span<u8> out)
+{
+	if (base)
+		std::memcpy(out.data(), base, out.size());
+	else
+		std::memset(out.data(), 0, out.size());
+
+	const u8* p = data.data();
+	const u8* end = p + data.size();
+	size_t i = 0;
+	while (p < end)
+	{
+		i += ReadVarint(p);
+		size_t changed = ReadVarint(p);
+		for (size_t j = 0; j < changed; j++)
+			out[i + j] ^= p[j];
+
+		p += changed;
+		i += changed;
+	}
+}
+
+bool RewindBuffer::Allocate(size_t size, bool keyframe, size_t& offset)
+{
+	while (!Place(size, offset))
+	{
+		// a delta needs its own keyframe to stay
+		if (count == 0 || (!keyframe && groups <= 1))
+			return false;
+
+		DropOldestGroup();
+	}
+
+	return true;
+}
+
+bool RewindBuffer::Place(size_t size, size_t& offset) const
+{
+	if (count == 0)
+	{
+		offset = 0;
+		return size <= arena.size();
+	}
+
+	// entries run from head to tail, wrapping around the end of the arena
+	size_t head = entries[first].offset;
+	if (tail > head)
+	{
+		if (arena.size() - tail >= size)
+		{
+			offset = tail;
+			return true;
+		}
+
+		offset = 0;
+		return size <= head;
+	}
+
+	offset = tail;
+	return head - tail >= size;
+}
+
+void RewindBuffer::DropOldestGroup()
+{
+	do
+	{
+		used -= entries[first].size;
+		first = (first + 1) % entries.size();
+		count--;
+	} while (count > 0 && !entries[first].keyframe);
+
+	groups--;
+	if (count == 0)
+		tail = 0;
+}
+
+void RewindBuffer::PushEntry(const Entry& e)
+{
+	if (count == entries.size())
+	{
+		// unwrap into a bigger ring
+		std::vector<Entry> grown(std::max<size_t>(entries.size() * 2, 256));
+		for (size_t i = 0; i < count; i++)
+			grown[i] = GetEntry(i);
+
+		entries.swap(grown);
+		first = 0;
+	}
+
+	GetEntry(count++) = e;
+}
@@ -0,0 +1,68 @@
+#pragma once
+#include "GamboDefine.h"
+#include <span>
+
+// the last few minutes of save states, newest last, packed into one block of
+// memory that's allocated up front. every KeyframeInterval-th state is kept
+// whole, the ones in between as the xor against their keyframe, and all of
+// them are run length encoded. little changes from one frame to the next, so
+// a delta is mostly zeroes and comes down to a few hundred bytes. once the
+// budget is used up the oldest keyframe goes, along with its deltas.
+class RewindBuffer
+{
+public:
+	RewindBuffer(size_t budget);
+
+	// false if the state doesn't fit even into an empty buffer
+	bool Push(std::span<const u8> state);
+
+	// takes the newest state out. false once there's nothing left.
+	bool Pop(std::vector<u8>& state);
+
+	void Clear();
+
+	// in bytes, 0 turns it off. throws away everything stored so far.
+	void SetBudget(size_t budget);
+	size_t GetBudget() const;
+	size_t GetUsed() const;
+	size_t GetCount() const;
+
+	static constexpr int KeyframeInterval = 60;
+
+private:
+	struct Entry
+	{
+		size_t offset;	// into the arena
+		u32 size;
+		bool keyframe;
+	};
+
+	// runs of unchanged bytes followed by runs of changed ones, both as a
+	// varint count, the changed bytes xored with base. a null base is all zeroes.
+	static void Encode(std::span<const u8> state, const u8* base, std::vector<u8>& out);
+	static void Decode(std::span<const u8> data, const u8* base, std::span<u8> out);
+
+	// makes room in the arena, dropping old groups as needed. deltas can't
+	// drop the group they belong to.
+	bool Allocate(size_t size, bool keyframe, size_t& offset);
+	bool Place(size_t size, size_t& offset) const;
+	void DropOldestGroup();
+
+	// the entries are a ring too, it only grows
+	Entry& GetEntry(size_t i) { return entries[(first + i) % entries.size()]; }
+	void PushEntry(const Entry& e);
+
+	std::vector<u8> arena;
+	size_t tail = 0;			// where the next entry goes
+	size_t used = 0;
+
+	std::vector<Entry> entries;
+	size_t first = 0;
+	size_t count = 0;
+	size_t groups = 0;			// keyframes stored
+
+	size_t stateSize = 0;
+	std::vector<u8> keyframe;	// the newest keyframe decoded, new deltas are made against it
+	int sinceKeyframe = 0;		// entries in the newest group, keyframe included
+	std::vector<u8> scratch;
+};
@@ -0,0 +1,73 @@
+#pragma once
+#include "GamboDefine.h"
+#include <cstring>
+#include <span>
+#include <type_traits>
+
+// save states are the raw bytes of each component's fields one after the
+// other, in the order the components write them. there's no per field
+// tagging, any change to what gets written needs a new version.
+class StateWriter
+{
+public:
+	StateWriter(std::vector<u8>& out) : out(out) {}
+
+	template<typename T> requires std::is_trivially_copyable_v<T>
+	void Write(const T& value)
+	{
+		Write(&value, sizeof(T));
+	}
+
+	void Write(const void* data, size_t size)
+	{
+		auto bytes = (const u8*)data;
+		out.insert(out.end(), bytes, bytes + size);
+	}
+
+private:
+	std::vector<u8>& out;
+};
+
+// reads past the end give zeroes and mark the reader as failed
+class StateReader
+{
+public:
+	StateReader(std::span<const u8> data) : data(data) {}
+
+	template<typename T> requires std::is_trivially_copyable_v<T>
+	void Read(T& value)
+	{
+		Read(&value, sizeof(T));
+	}
+
+	template<typename T> requires std::is_trivially_copyable_v<T>
+	T Read()
+	{
+		T value;
+		Read(&value, sizeof(T));
+		return value;
+	}
+
+	void Read(void* out, size_t size)
+	{
+		if (size > data.size() - position)
+		{
+			std::memset(out, 0, size);
+			failed = true;
+			return;
+		}
+
+		std::memcpy(out, data.data() + position, size);
+		position += size;
+	}
+
+	bool IsGood() const
+	{
+		return !failed;
+	}
+
+private:
+	std::span<const u8> data;
+	size_t position = 0;
+	bool failed = false;
+};
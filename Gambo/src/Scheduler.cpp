@@ -0,0 +1,39 @@
+#include "Scheduler.h"
+#include "SaveState.h"
+#include <algorithm>
+
+void Scheduler::Reset()
+{
+	now = 0;
+	deadlines.fill(Never);
+	nextDeadline = Never;
+}
+
+void Scheduler::SaveState(StateWriter& w) const
+{
+	w.Write(now);
+	w.Write(deadlines);
+}
+
+void Scheduler::LoadState(StateReader& r)
+{
+	r.Read(now);
+	r.Read(deadlines);
+	UpdateNextDeadline();
+}
+
+void Scheduler::Schedule(SchedulerEvent event, u64 when)
+{
+	deadlines[(size_t)event] = when;
+	UpdateNextDeadline();
+}
+
+void Scheduler::Cancel(SchedulerEvent event)
+{
+	Schedule(event, Never);
+}
+
+void Scheduler::UpdateNextDeadline()
+{
+	nextDeadline = *std::min_element(deadlines.begin(), deadlines.end());
+}
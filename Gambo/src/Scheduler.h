@@ -0,0 +1,45 @@
+#pragma once
+#include "GamboDefine.h"
+
+class StateWriter;
+class StateReader;
+
+// points in the future where a component does something the cpu can notice
+enum class SchedulerEvent : u8
+{
+	PPU,		// next mode or LY change
+	Timer,		// TIMA overflow
+	FrameLimit,	// the lcd was kept from finishing a frame for too long
+	Count,
+};
+
+// the master clock and the next deadline of every component. the cpu runs
+// on its own until the earliest deadline comes up, the other components are
+// only caught up then or when the cpu touches their registers.
+class Scheduler
+{
+public:
+	static constexpr u64 Never = ~0ull;
+
+	void Reset();
+	void SaveState(StateWriter& w) const;
+	void LoadState(StateReader& r);
+	void Schedule(SchedulerEvent event, u64 when);
+	void Cancel(SchedulerEvent event);
+
+	u64 GetNow() const { return now; }
+	u64 GetNextDeadline() const { return nextDeadline; }
+	void Advance(int cycles) { now += cycles; }
+	bool IsDue() const { return now >= nextDeadline; }
+	bool IsDue(SchedulerEvent event) const { return now >= deadlines[(size_t)event]; }
+
+private:
+	void UpdateNextDeadline();
+
+	u64 now = 0;
+	u64 nextDeadline = Never;
+
+	// there are only a handful of event sources, so the queue is just their
+	// deadlines and the earliest one is found by looking at all of them
+	std::array<u64, (size_t)SchedulerEvent::Count> deadlines{};
+};
@@ -0,0 +1,66 @@
+#include "Trace.h"
+#include <algorithm>
+#include <bit>
+#include <fstream>
+
+TraceBuffer::TraceBuffer(size_t capacity)
+	: entries(std::bit_ceil(std::max<size_t>(capacity, 1)))
+	, mask(entries.size() - 1)
+{
+}
+
+void TraceBuffer::CopyTo(std::vector<TraceEntry>& out) const
+{
+	u64 end = written.load(std::memory_order_acquire);
+	u64 begin = end > entries.size() ? end - entries.size() : 0;
+
+	out.resize(end - begin);
+	for (u64 i = begin; i < end; i++)
+		out[i - begin] = entries[i & mask];
+}
+
+size_t TraceBuffer::GetCapacity() const
+{
+	return entries.size();
+}
+
+u64 TraceBuffer::GetTotalRecorded() const
+{
+	return written.load(std::memory_order_acquire);
+}
+
+void TraceBuffer::Clear()
+{
+	written.store(0, std::memory_order_release);
+}
+
+bool TraceBuffer::Save(const std::filesystem::path& path) const
+{
+	std::vector<TraceEntry> ordered;
+	CopyTo(ordered);
+
+	std::ofstream file(path, std::ios::binary);
+	if (!file.is_open())
+		return false;
+
+	FileHeader header = { FileMagic, FileVersion, sizeof(TraceEntry), ordered.size() };
+	file.write((const char*)&header, sizeof(header));
+	file.write((const char*)ordered.data(), ordered.size() * sizeof(TraceEntry));
+	return file.good();
+}
+
+bool TraceBuffer::Load(const std::filesystem::path& path, std::vector<TraceEntry>& out)
+{
+	std::ifstream file(path, std::ios::binary);
+	if (!file.is_open())
+		return false;
+
+	FileHeader header = {};
+	file.read((char*)&header, sizeof(header));
+	if (!file || header.magic != FileMagic || header.version != FileVersion || header.entrySize != sizeof(TraceEntry))
+		return false;
+
+	out.resize(header.count);
+	file.read((char*)out.data(), out.size() * sizeof(TraceEntry));
+	return file.good();
+}
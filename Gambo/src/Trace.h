@@ -0,0 +1,59 @@
+#pragma once
+#include "GamboDefine.h"
+
+// one instruction, recorded just before it runs
+struct TraceEntry
+{
+	u64 cycle;					// master clock
+	u16 PC;
+	u16 SP;
+	u16 bank;					// rom bank PC is in, 0 outside of rom
+	u8 A, F, B, C, D, E, H, L;
+	std::array<u8, 4> pcmem;	// the bytes at PC, what gameboy-doctor logs show
+	u8 IME;
+	std::array<u8, 5> unused;
+};
+static_assert(sizeof(TraceEntry) == 32, "trace files depend on this layout");
+
+// the last N instructions in a fixed size ring. the emulation thread is the
+// only writer and never waits, so it's cheap enough to leave on. readers on
+// other threads may see a torn entry at the position being overwritten.
+class TraceBuffer
+{
+public:
+	// capacity is rounded up to a power of two
+	TraceBuffer(size_t capacity);
+
+	void Record(const TraceEntry& entry)
+	{
+		u64 n = written.load(std::memory_order_relaxed);
+		entries[n & mask] = entry;
+		written.store(n + 1, std::memory_order_release);
+	}
+
+	// oldest first
+	void CopyTo(std::vector<TraceEntry>& out) const;
+	size_t GetCapacity() const;
+	u64 GetTotalRecorded() const;
+	void Clear();
+
+	// a small header followed by the entries, oldest first, in host byte order
+	bool Save(const std::filesystem::path& path) const;
+	static bool Load(const std::filesystem::path& path, std::vector<TraceEntry>& out);
+
+private:
+	static constexpr u32 FileMagic = 0x52544247; // "GBTR"
+	static constexpr u16 FileVersion = 1;
+
+	struct FileHeader
+	{
+		u32 magic;
+		u16 version;
+		u16 entrySize;
+		u64 count;
+	};
+
+	std::vector<TraceEntry> entries;
+	u64 mask;
+	std::atomic<u64> written = 0;
+};
@@ -0,0 +1,47 @@
+#pragma once
+#include "GamboDefine.h"
+
+// single producer, single consumer triple buffer. the producer always has a
+// buffer to write into and the consumer always has the newest finished one to
+// read, so neither side ever waits on the other. frames the consumer didn't
+// get to in time are simply overwritten.
+template<typename T>
+class TripleBuffer
+{
+public:
+	// producer side
+	T& GetWriteBuffer()
+	{
+		return buffers[writeIndex];
+	}
+
+	void Publish()
+	{
+		// hand the finished buffer over and take back whichever one was waiting
+		writeIndex = middle.exchange(writeIndex | DirtyBit, std::memory_order_acq_rel) & IndexMask;
+	}
+
+	// consumer side. returns true if a newer buffer was picked up.
+	bool Update()
+	{
+		if (!(middle.load(std::memory_order_relaxed) & DirtyBit))
+			return false;
+
+		readIndex = middle.exchange(readIndex, std::memory_order_acq_rel) & IndexMask;
+		return true;
+	}
+
+	const T& GetReadBuffer() const
+	{
+		return buffers[readIndex];
+	}
+
+private:
+	static constexpr u8 IndexMask = 0b11;
+	static constexpr u8 DirtyBit = 0b100;
+
+	std::array<T, 3> buffers{};
+	std::atomic<u8> middle = 1;
+	u8 writeIndex = 0;
+	u8 readIndex = 2;
+};
@@ -1,5 +1,5 @@
 #include "VramViewer.h"
-#include "Ram.h"
+#include "RAM.h"
 #include "PPU.h"
 
 VramViewer::VramViewer(RAM* r)
@@ -13,7 +13,7 @@ VramViewer::~VramViewer()
 {
 }
 
-const std::array<SDL_Color, 256 * 256>& VramViewer::GetView()
+const std::array<Color, 256 * 256>& VramViewer::GetView()
 {
 	const u8 LCDC = Read(HWAddr::LCDC);
 	const u8 SCY = Read(HWAddr::SCY);	// viewport y position
@@ -9,7 +9,7 @@ public:
 	VramViewer(RAM* c);
 	~VramViewer();
 
-	const std::array<SDL_Color, 256 * 256>& GetView();
+	const std::array<Color, 256 * 256>& GetView();
 	void SetTileMapBaseAddr(int addr);
 	void SetTileDataBaseAddr(int addr);
 
@@ -23,6 +23,6 @@ private:
 	int _tileDataBaseAddr = 0x8000;
 
 	RAM* ram;
-	std::array<SDL_Color, 256 * 256> bg0;
-	std::array<SDL_Color, 256 * 256> bg1;
+	std::array<Color, 256 * 256> bg0;
+	std::array<Color, 256 * 256> bg1;
 };
\ No newline at end of file
@@ -11,6 +11,8 @@ public:
 
 	virtual const u8 Read(u8 addr) const = 0;
 	virtual void Reset() = 0;
+
+	const u8* GetData() const { return rom.data(); }
 private:
 	std::array<u8, 256> rom;
 };
\ No newline at end of file
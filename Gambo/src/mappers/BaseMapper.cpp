@@ -0,0 +1,28 @@
+#include "BaseMapper.h"
+#include "Cartridge.h"
+
+u32 BaseMapper::GetRomOffset(u16 addr) const
+{
+	return (u32)(GetRomBank(addr) - cart->rom.data()) + (addr & 0x3FFF);
+}
+
+void BaseMapper::SetRomBanks(u32 bank0, u32 bank1)
+{
+	// the rom is padded to whole banks when it's loaded
+	u32 banks = (u32)(cart->rom.size() / 16KiB);
+	if (banks == 0)
+	{
+		// nothing loaded
+		romBanks = {};
+		return;
+	}
+
+	romBanks[0] = cart->rom.data() + (bank0 % banks) * 16KiB;
+	romBanks[1] = cart->rom.data() + (bank1 % banks) * 16KiB;
+}
+
+void BaseMapper::SetRamBank(bool enabled, u32 bank)
+{
+	u32 banks = (u32)(cart->ram.size() / 8KiB);
+	ramBank = enabled && banks > 0 ? cart->ram.data() + (bank % banks) * 8KiB : nullptr;
+}
@@ -2,20 +2,42 @@
 #include "GamboDefine.h"
 
 class Cartridge;
+class StateWriter;
+class StateReader;
 
 class BaseMapper
 {
 	BaseMapper() = delete;
 public:
 	BaseMapper(Cartridge* cartridge) : cart(cartridge) {};
-	virtual ~BaseMapper() {};
 
-	virtual u8 Read(u16 addr) = 0;
-	virtual void Write(u16 addr, u8 data) = 0;
+	// every mapper also has
+	//	u8 Read(u16 addr) const;
+	//	void Write(u16 addr, u8 data);
+	//	void SaveState(StateWriter& w) const;
+	//	void LoadState(StateReader& r);		// registers only, the cartridge saves the ram
+	// the cartridge knows which one it has at compile time, so they aren't virtual.
+
+	// the 16 KiB rom bank mapped at addr ($0000-$7FFF)
+	const u8* GetRomBank(u16 addr) const { return romBanks[(addr >> 14) & 1]; }
+
+	// the 8 KiB of cartridge ram mapped at $A000, null while it's disabled
+	u8* GetRamBank() const { return ramBank; }
+
+	// offset into the rom of whatever is mapped at addr ($0000-$7FFF)
+	u32 GetRomOffset(u16 addr) const;
 
 	bool operator==(const BaseMapper& other) const = delete;
 
 protected:
+	// the mappers call these whenever a control register changes. banks past
+	// the end of the rom or ram wrap around like they do on hardware.
+	void SetRomBanks(u32 bank0, u32 bank1);
+	void SetRamBank(bool enabled, u32 bank);
+
 	Cartridge* cart;
-};
 
+private:
+	std::array<const u8*, 2> romBanks{};
+	u8* ramBank = nullptr;
+};
@@ -1,5 +1,6 @@
 #include "MBC1.h"
 #include "Cartridge.h"
+#include "SaveState.h"
 
 MBC1::MBC1(Cartridge* cart)
 	: BaseMapper(cart)
@@ -7,8 +8,9 @@ MBC1::MBC1(Cartridge* cart)
 	, romBankNumber(0)
 	, ramBankNumber(0)
 	, bankingModeSelect(0)
-	, bankNumberBitWidth(0)
+	, romBankMask(0)
 {
+	int bankNumberBitWidth = 0;
 	int numberOfBanks = cart->GetRomBanks();
 	while (numberOfBanks > 1)
 	{
@@ -19,84 +21,36 @@ MBC1::MBC1(Cartridge* cart)
 		if (bankNumberBitWidth == 5)
 			break;
 	}
+
+	romBankMask = (1 << bankNumberBitWidth) - 1;
+	UpdateBanks();
 }
 
 MBC1::~MBC1()
 {
 }
 
-u8 MBC1::Read(u16 addr)
+u8 MBC1::Read(u16 addr) const
 {
-	// mbc1 supports up to 2mb rom and/or 32kb ram so we actually only need 21 bits in this u32.
-	u32 wAddr = 0;
-
-	if (0x0000 <= addr && addr <= 0x3FFF)
+	if (0xA000 <= addr && addr <= 0xBFFF)
 	{
-		if (bankingModeSelect == 0)
-		{
-			// bits 0-13 come from gameboy address.
-			// other 7 bits are always 0;
-			wAddr = addr & 0x3FFF;
-		}
-		else
-		{
-			// bits 0-13 come from gameboy address.
-			wAddr = addr & 0x3FFF;
-
-			// bits 14-18 are always 0 and bits 19-20
-			// come from ramBankNumber
-			wAddr |= ramBankNumber << 19;
-		}
+		// if ram is disabled, reads return open bus values,
+		// often 0xFF, but not guaranteed, but who cares. for
+		// now, always 0xFF
+		const u8* ram = GetRamBank();
+		return ram ? ram[addr & 0x1FFF] : 0xFF;
 	}
-	else if (0x4000 <= addr && addr <= 0x7FFF)
-	{
-		// bits 0-13 come from gameboy address.
-		wAddr = addr & 0x3FFF;
-
-		// bits 14-18 are from the rom bank number
-		if (romBankNumber == 0)
-		{
-			wAddr |= 1 << 14;
-		}
-		else
-		{
-			wAddr |= romBankNumber << 14;
-		}
 
-		// bits 19-20 come from ramBankNumber
-		wAddr |= ramBankNumber << 19;
-	}
-	else if (0xA000 <= addr && addr <= 0xBFFF)
-	{
-		if (ramEnabled)
-		{
-			if (bankingModeSelect == 0)
-			{
-				// bits 0-12 come from gameboy address.
-				// bits 13-14 are always 0;
-				wAddr = addr & 0x1FFF;
-			}
-			else
-			{
-				// bits 0-12 come from gameboy address.
-				wAddr = addr & 0x1FFF;
-
-				// bits 13-14 come from ramBankNumber
-				wAddr |= ramBankNumber << 13;
-			}
-
-			return cart->ram[wAddr];
-		}
-		else
-		{
-			// if ram is disabled, reads return open bus values,
-			// often 0xFF, but not guaranteed, but who cares. for
-			// now, always 0xFF
-			return 0xFF;
-		}
-	}
+	return GetRomBank(addr)[addr & 0x3FFF];
+}
 
-	return cart->rom[wAddr];
+void MBC1::UpdateBanks()
+{
+	// the ram bank register doubles as bits 5-6 of the rom bank. in banking
+	// mode 1 it also applies to the bank at $0000 and selects the ram bank.
+	u32 upperBits = ramBankNumber << 5;
+	SetRomBanks(bankingModeSelect ? upperBits : 0, (romBankNumber == 0 ? 1 : romBankNumber) | upperBits);
+	SetRamBank(ramEnabled, bankingModeSelect ? ramBankNumber : 0);
 }
 
 void MBC1::Write(u16 addr, u8 data)
@@ -112,21 +66,13 @@ void MBC1::Write(u16 addr, u8 data)
 	}
 	else if (0x2000 <= addr && addr <= 0x3FFF)
 	{
-		// figure out our bit mask
-		int bitMask = 0;
-		for (size_t i = 0; i < bankNumberBitWidth; i++)
-		{
-			bitMask <<= 1;
-			bitMask += 1;
-		}
-
 		// if the bottom 5 bits of data is 0, set rom bank number to 1, otherwise
 		// rom bank number only uses the bits it needs according to the rom size.
 		// this makes it possible to map bank 0 if the bit width is less than 5,  
 		// meaning the rom is 256k or smaller. You can do this by setting any bits 
 		// above the bit width to 1, causing the comparison to fail, and bank 0 to 
 		// be mapped. example: the bit width is 3 and you write 0b01000. 
-		romBankNumber = (data & 0b11111) == 0 ? 1 : data & bitMask;
+		romBankNumber = (data & 0b11111) == 0 ? 1 : data & romBankMask;
 	}
 	else if (0x4000 <= addr && addr <= 0x5FFF)
 	{
@@ -140,30 +86,29 @@ void MBC1::Write(u16 addr, u8 data)
 	}
 	else if (0xA000 <= addr && addr <= 0xBFFF)
 	{
-		// writing to cartridge ram
-		if (ramEnabled)
-		{
-			u16 wAddr = 0;
-			if (bankingModeSelect == 0)
-			{
-				// bits 0-12 come from gameboy address.
-				// bits 13-14 are always 0;
-				wAddr = addr & 0x1FFF;
-			}
-			else
-			{
-				// bits 0-12 come from gameboy address.
-				wAddr = addr & 0x1FFF;
+		// writes are ignored if ram is disabled
+		if (u8* ram = GetRamBank())
+			ram[addr & 0x1FFF] = data;
 
-				// bits 13-14 come from ramBankNumber
-				wAddr |= ramBankNumber << 12;
-			}
-
-			cart->ram[wAddr] = data;
-		}
-		else
-		{
-			// writes are ignored if ram is disabled
-		}
+		return;
 	}
+
+	UpdateBanks();
+}
+
+void MBC1::SaveState(StateWriter& w) const
+{
+	w.Write(ramEnabled);
+	w.Write(romBankNumber);
+	w.Write(ramBankNumber);
+	w.Write(bankingModeSelect);
+}
+
+void MBC1::LoadState(StateReader& r)
+{
+	r.Read(ramEnabled);
+	r.Read(romBankNumber);
+	r.Read(ramBankNumber);
+	r.Read(bankingModeSelect);
+	UpdateBanks();
 }
\ No newline at end of file
@@ -12,16 +12,19 @@ public:
     MBC1(Cartridge* cart);
     ~MBC1();
 
-    u8 Read(u16 addr) override;
-    void Write(u16 addr, u8 data) override;
+    u8 Read(u16 addr) const;
+    void Write(u16 addr, u8 data);
+    void SaveState(StateWriter& w) const;
+    void LoadState(StateReader& r);
 
     bool operator==(const MBC1& other) const = delete;
 
 private:
+    void UpdateBanks();
+
     bool ramEnabled;
     u8 romBankNumber;
     u8 ramBankNumber;
     bool bankingModeSelect;
-    u8 bankNumberBitWidth;
+    u8 romBankMask;
 };
-
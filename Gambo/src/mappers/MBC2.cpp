@@ -0,0 +1,72 @@
+#include "MBC2.h"
+#include "Cartridge.h"
+#include "SaveState.h"
+
+MBC2::MBC2(Cartridge* cart)
+	: BaseMapper(cart)
+	, ramEnabled(0)
+	, romBankNumber(1)
+{
+	// the ram is only 4 bits wide, so it never goes in the page table and
+	// always comes through Read/Write
+	SetRomBanks(0, romBankNumber);
+}
+
+MBC2::~MBC2()
+{
+}
+
+u8 MBC2::Read(u16 addr) const
+{
+	if (0xA000 <= addr && addr <= 0xBFFF)
+	{
+		if (!ramEnabled)
+			return 0xFF;
+
+		// only the bottom 9 bits of the address are used, so the ram repeats
+		// through the whole area. the top half of each byte is open bus.
+		return 0xF0 | cart->ram[addr & (RamSize - 1)];
+	}
+
+	return GetRomBank(addr)[addr & 0x3FFF];
+}
+
+void MBC2::Write(u16 addr, u8 data)
+{
+	if (0x0000 <= addr && addr <= 0x3FFF)
+	{
+		// both registers live in the same range, bit 8 of the address picks
+		// which one is written
+		if (addr & 0x100)
+		{
+			// 4 bit rom bank number, bank 0 maps bank 1 instead
+			romBankNumber = (data & 0x0F) == 0 ? 1 : data & 0x0F;
+			SetRomBanks(0, romBankNumber);
+		}
+		else
+		{
+			// writing exactly 0xA in the bottom nybble enables ram. anything else
+			// disables ram.
+			ramEnabled = (data & 0x0F) == 0x0A;
+		}
+	}
+	else if (0xA000 <= addr && addr <= 0xBFFF)
+	{
+		// writes are ignored if ram is disabled
+		if (ramEnabled)
+			cart->ram[addr & (RamSize - 1)] = data & 0x0F;
+	}
+}
+
+void MBC2::SaveState(StateWriter& w) const
+{
+	w.Write(ramEnabled);
+	w.Write(romBankNumber);
+}
+
+void MBC2::LoadState(StateReader& r)
+{
+	r.Read(ramEnabled);
+	r.Read(romBankNumber);
+	SetRomBanks(0, romBankNumber);
+}
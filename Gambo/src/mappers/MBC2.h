@@ -0,0 +1,28 @@
+#pragma once
+#include "BaseMapper.h"
+
+class Cartridge;
+
+class MBC2 :
+    public BaseMapper
+{
+    MBC2() = delete;
+public:
+
+    MBC2(Cartridge* cart);
+    ~MBC2();
+
+    u8 Read(u16 addr) const;
+    void Write(u16 addr, u8 data);
+    void SaveState(StateWriter& w) const;
+    void LoadState(StateReader& r);
+
+    bool operator==(const MBC2& other) const = delete;
+
+    // mbc2 has 512 half bytes of ram built in, the header says there's none
+    static constexpr u32 RamSize = 512;
+
+private:
+    bool ramEnabled;
+    u8 romBankNumber;
+};
@@ -12,15 +12,19 @@ public:
     MBC3(Cartridge* cart);
     ~MBC3();
 
-    u8 Read(u16 addr) override;
-    void Write(u16 addr, u8 data) override;
+    u8 Read(u16 addr) const;
+    void Write(u16 addr, u8 data);
+    void SaveState(StateWriter& w) const;
+    void LoadState(StateReader& r);
 
     bool operator==(const MBC3& other) const = delete;
 
 private:
+    void UpdateBanks();
+
     bool ramAndRTCEnabled;
     u8 romBankNumber;
     u8 ramBankNumber;
     bool bankingModeSelect;
-    u8 bankNumberBitWidth;
-};
\ No newline at end of file
+    u8 romBankMask;
+};
@@ -0,0 +1,101 @@
+#include "MBC5.h"
+#include "Cartridge.h"
+#include "SaveState.h"
+
+MBC5::MBC5(Cartridge* cart)
+	: BaseMapper(cart)
+	, ramEnabled(0)
+	, romBankNumber(1)
+	, ramBankNumber(0)
+	, ramBankMask(0b1111)
+{
+	// on rumble carts bit 3 of the ram bank register drives the motor instead
+	switch (cart->GetMapperType())
+	{
+		case MapperType::MBC5_RUMBLE:
+		case MapperType::MBC5_RUMBLE_RAM:
+		case MapperType::MBC5_RUMBLE_RAM_BATTERY:
+			ramBankMask = 0b111;
+			break;
+
+		default:
+			break;
+	}
+
+	UpdateBanks();
+}
+
+MBC5::~MBC5()
+{
+}
+
+u8 MBC5::Read(u16 addr) const
+{
+	if (0xA000 <= addr && addr <= 0xBFFF)
+	{
+		// if ram is disabled, reads return open bus values. for now, always 0xFF
+		const u8* ram = GetRamBank();
+		return ram ? ram[addr & 0x1FFF] : 0xFF;
+	}
+
+	return GetRomBank(addr)[addr & 0x3FFF];
+}
+
+void MBC5::UpdateBanks()
+{
+	// unlike mbc1, bank 0 can be mapped at $4000 and the bank at $0000 never changes
+	SetRomBanks(0, romBankNumber);
+	SetRamBank(ramEnabled, ramBankNumber);
+}
+
+void MBC5::Write(u16 addr, u8 data)
+{
+	if (0x0000 <= addr && addr <= 0x1FFF)
+	{
+		// writing exactly 0xA in the bottom nybble enables ram. anything else
+		// disables ram.
+		if (cart->GetRamSize() > 0)
+			ramEnabled = (data & 0x0F) == 0x0A;
+		else
+			ramEnabled = false;
+	}
+	else if (0x2000 <= addr && addr <= 0x2FFF)
+	{
+		// bottom 8 bits of the 9 bit rom bank number
+		romBankNumber = (romBankNumber & 0x100) | data;
+	}
+	else if (0x3000 <= addr && addr <= 0x3FFF)
+	{
+		// bit 8 of the rom bank number
+		romBankNumber = (romBankNumber & 0xFF) | (data & 0b1) << 8;
+	}
+	else if (0x4000 <= addr && addr <= 0x5FFF)
+	{
+		ramBankNumber = data & ramBankMask;
+	}
+	else if (0xA000 <= addr && addr <= 0xBFFF)
+	{
+		// writes are ignored if ram is disabled
+		if (u8* ram = GetRamBank())
+			ram[addr & 0x1FFF] = data;
+
+		return;
+	}
+
+	UpdateBanks();
+}
+
+void MBC5::SaveState(StateWriter& w) const
+{
+	w.Write(ramEnabled);
+	w.Write(romBankNumber);
+	w.Write(ramBankNumber);
+}
+
+void MBC5::LoadState(StateReader& r)
+{
+	r.Read(ramEnabled);
+	r.Read(romBankNumber);
+	r.Read(ramBankNumber);
+	UpdateBanks();
+}
@@ -0,0 +1,29 @@
+#pragma once
+#include "BaseMapper.h"
+
+class Cartridge;
+
+class MBC5 :
+    public BaseMapper
+{
+    MBC5() = delete;
+public:
+
+    MBC5(Cartridge* cart);
+    ~MBC5();
+
+    u8 Read(u16 addr) const;
+    void Write(u16 addr, u8 data);
+    void SaveState(StateWriter& w) const;
+    void LoadState(StateReader& r);
+
+    bool operator==(const MBC5& other) const = delete;
+
+private:
+    void UpdateBanks();
+
+    bool ramEnabled;
+    u16 romBankNumber;
+    u8 ramBankNumber;
+    u8 ramBankMask;
+};
@@ -0,0 +1,46 @@
+#include "RomOnly.h"
+#include "Cartridge.h"
+#include "SaveState.h"
+
+RomOnly::RomOnly(Cartridge* cart)
+	: BaseMapper(cart)
+{
+	// without a mapper there's nothing to enable ram with, if the cartridge
+	// has any it's always there
+	SetRomBanks(0, 1);
+	SetRamBank(true, 0);
+}
+
+RomOnly::~RomOnly()
+{
+}
+
+u8 RomOnly::Read(u16 addr) const
+{
+	if (0xA000 <= addr && addr <= 0xBFFF)
+	{
+		const u8* ram = GetRamBank();
+		return ram ? ram[addr & 0x1FFF] : 0xFF;
+	}
+
+	return GetRomBank(addr)[addr & 0x3FFF];
+}
+
+void RomOnly::Write(u16 addr, u8 data)
+{
+	// there are no registers, writes to rom do nothing
+	if (0xA000 <= addr && addr <= 0xBFFF)
+	{
+		if (u8* ram = GetRamBank())
+			ram[addr & 0x1FFF] = data;
+	}
+}
+
+// nothing to it but the ram, which the cartridge saves
+void RomOnly::SaveState(StateWriter& w) const
+{
+}
+
+void RomOnly::LoadState(StateReader& r)
+{
+}
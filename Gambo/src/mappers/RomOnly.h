@@ -0,0 +1,22 @@
+#pragma once
+#include "BaseMapper.h"
+
+class Cartridge;
+
+// no mapper at all, just 32 KiB of rom and maybe 8 KiB of ram
+class RomOnly :
+    public BaseMapper
+{
+    RomOnly() = delete;
+public:
+
+    RomOnly(Cartridge* cart);
+    ~RomOnly();
+
+    u8 Read(u16 addr) const;
+    void Write(u16 addr, u8 data);
+    void SaveState(StateWriter& w) const;
+    void LoadState(StateReader& r);
+
+    bool operator==(const RomOnly& other) const = delete;
+};
@@ -0,0 +1,58 @@
+// runs a rom headless with the profiler on and writes where the cycles went.
+//
+// usage: gambo_profile <rom.gb> <frames> <out.folded> [rom.sym] [hotspots]
+//
+// out.folded gets collapsed stacks for flamegraph.pl, inferno or speedscope.
+// the most expensive instructions are printed, 20 unless hotspots says otherwise.
+
+#include "GamboCore.h"
+#include "Cartridge.h"
+#include "Profiler.h"
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+int main(int argc, char** argv)
+{
+	if (argc < 4)
+	{
+		std::fprintf(stderr, "usage: gambo_profile <rom.gb> <frames> <out.folded> [rom.sym] [hotspots]\n");
+		return 2;
+	}
+
+	int frames = std::atoi(argv[2]);
+	size_t hotSpots = argc > 5 ? std::atoi(argv[5]) : 20;
+
+	GamboCore gambo;
+	gambo.SetRandomSeed(0);
+	gambo.InsertCartridge(argv[1]);
+	if (!gambo.GetCartridge().IsMapperSupported())
+	{
+		std::fprintf(stderr, "could not load %s\n", argv[1]);
+		return 1;
+	}
+
+	gambo.SetProfiling(true);
+	auto profiler = gambo.GetProfiler();
+	if (argc > 4 && *argv[4] && !profiler->LoadSymbols(argv[4]))
+	{
+		std::fprintf(stderr, "could not read %s\n", argv[4]);
+		return 1;
+	}
+
+	for (int i = 0; i < frames; i++)
+		gambo.RunFrame();
+
+	std::ofstream stacks(argv[3]);
+	profiler->WriteCollapsedStacks(stacks);
+	if (!stacks.good())
+	{
+		std::fprintf(stderr, "could not write %s\n", argv[3]);
+		return 1;
+	}
+
+	std::cout << profiler->GetTotalCycles() << " cycles\n";
+	profiler->WriteHotSpots(std::cout, hotSpots);
+	return 0;
+}
@@ -0,0 +1,174 @@
+// records and converts the binary traces written by GamboCore::SetTraceSize.
+//
+// usage: gambo_trace record <rom.gb> <frames> <out.gbtrace> [boot]
+//        gambo_trace doctor <in.gbtrace>
+//        gambo_trace diff <a> <b> [context]
+//
+// doctor prints the gameboy-doctor log format. diff compares two traces, or
+// a trace against a gameboy-doctor log from another emulator, and shows
+// where they first disagree.
+
+#include "GamboCore.h"
+#include "Cartridge.h"
+#include "Trace.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+static std::string FormatDoctorLine(const TraceEntry& e)
+{
+	char line[96];
+	std::snprintf(line, sizeof(line),
+		"A:%02X F:%02X B:%02X C:%02X D:%02X E:%02X H:%02X L:%02X SP:%04X PC:%04X PCMEM:%02X,%02X,%02X,%02X",
+		e.A, e.F, e.B, e.C, e.D, e.E, e.H, e.L, e.SP, e.PC, e.pcmem[0], e.pcmem[1], e.pcmem[2], e.pcmem[3]);
+	return line;
+}
+
+// reads either kind of trace as gameboy-doctor lines. the binary ones also
+// keep their entries for the extra detail diff prints.
+static bool LoadLines(const char* path, std::vector<std::string>& lines, std::vector<TraceEntry>& entries)
+{
+	if (TraceBuffer::Load(path, entries))
+	{
+		for (auto& e : entries)
+			lines.push_back(FormatDoctorLine(e));
+		return true;
+	}
+
+	std::ifstream file(path);
+	if (!file.is_open())
+		return false;
+
+	std::string line;
+	while (std::getline(file, line))
+	{
+		if (!line.empty() && line.back() == '\r')
+			line.pop_back();
+		if (!line.empty())
+			lines.push_back(line);
+	}
+	return true;
+}
+
+static int Record(int argc, char** argv)
+{
+	if (argc < 5)
+		return 2;
+
+	int frames = std::atoi(argv[3]);
+
+	GamboCore gambo;
+	gambo.SetRandomSeed(0);
+	gambo.SetUseBootRom(argc > 5 && std::string_view(argv[5]) == "boot");
+	gambo.InsertCartridge(argv[2]);
+	if (!gambo.GetCartridge().IsMapperSupported())
+	{
+		std::fprintf(stderr, "could not load %s\n", argv[2]);
+		return 1;
+	}
+
+	// big enough for the whole run, a frame is at most 17556 instructions
+	gambo.SetTraceSize((size_t)frames * 17556 + 1);
+	for (int i = 0; i < frames; i++)
+		gambo.RunFrame();
+
+	auto trace = gambo.GetTrace();
+	if (!trace->Save(argv[4]))
+	{
+		std::fprintf(stderr, "could not write %s\n", argv[4]);
+		return 1;
+	}
+
+	std::printf("%llu instructions\n", (unsigned long long)trace->GetTotalRecorded());
+	return 0;
+}
+
+static int Doctor(int argc, char** argv)
+{
+	if (argc < 3)
+		return 2;
+
+	std::vector<TraceEntry> entries;
+	if (!TraceBuffer::Load(argv[2], entries))
+	{
+		std::fprintf(stderr, "could not read %s\n", argv[2]);
+		return 1;
+	}
+
+	for (auto& e : entries)
+		std::printf("%s\n", FormatDoctorLine(e).c_str());
+
+	return 0;
+}
+
+static int Diff(int argc, char** argv)
+{
+	if (argc < 4)
+		return 2;
+
+	size_t context = argc > 4 ? std::atoi(argv[4]) : 8;
+
+	std::vector<std::string> a, b;
+	std::vector<TraceEntry> entriesA, entriesB;
+	if (!LoadLines(argv[2], a, entriesA) || !LoadLines(argv[3], b, entriesB))
+	{
+		std::fprintf(stderr, "could not read traces\n");
+		return 1;
+	}
+
+	auto describe = [](const std::vector<TraceEntry>& entries, size_t i) {
+		char s[48] = "";
+		if (i < entries.size())
+			std::snprintf(s, sizeof(s), "  bank %03X cycle %llu", entries[i].bank, (unsigned long long)entries[i].cycle);
+		return std::string(s);
+	};
+
+	size_t count = std::min(a.size(), b.size());
+	for (size_t i = 0; i < count; i++)
+	{
+		if (a[i] == b[i])
+			continue;
+
+		std::printf("traces differ at instruction %zu\n", i);
+		for (size_t j = i > context ? i - context : 0; j < i; j++)
+			std::printf("  %s%s\n", a[j].c_str(), describe(entriesA, j).c_str());
+
+		std::printf("- %s%s\n", a[i].c_str(), describe(entriesA, i).c_str());
+		std::printf("+ %s%s\n", b[i].c_str(), describe(entriesB, i).c_str());
+		return 1;
+	}
+
+	if (a.size() != b.size())
+	{
+		std::printf("traces match for %zu instructions, then %s ends\n", count, a.size() < b.size() ? argv[2] : argv[3]);
+		return 1;
+	}
+
+	std::printf("traces match, %zu instructions\n", count);
+	return 0;
+}
+
+int main(int argc, char** argv)
+{
+	std::string_view command = argc > 1 ? argv[1] : "";
+
+	int result = 2;
+	if (command == "record")
+		result = Record(argc, argv);
+	else if (command == "doctor")
+		result = Doctor(argc, argv);
+	else if (command == "diff")
+		result = Diff(argc, argv);
+
+	if (result == 2)
+	{
+		std::fprintf(stderr,
+			"usage: gambo_trace record <rom.gb> <frames> <out.gbtrace> [boot]\n"
+			"       gambo_trace doctor <in.gbtrace>\n"
+			"       gambo_trace diff <a> <b> [context]\n");
+	}
+
+	return result;
+}